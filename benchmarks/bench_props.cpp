@@ -0,0 +1,190 @@
+// Props microbenchmark: interned-key small-vector layout vs. the previous
+// two-map layout (std::unordered_map<std::string, ...> for values and types),
+// plus the typed BuiltinProps fields written by PropsBuilder.
+// Mirrors the renderer access pattern: a handful of props per node, read
+// several times per frame.
+#include "reactpp/core/Props.hpp"
+#include <any>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace reactpp;
+
+namespace {
+
+// The pre-atom Props storage, kept here only for comparison
+class LegacyProps {
+public:
+    template<typename T>
+    void set(const std::string& key, const T& value) {
+        props_[key] = value;
+        types_.insert_or_assign(key, std::type_index(typeid(T)));
+    }
+    
+    template<typename T>
+    T get(const std::string& key) const {
+        auto it = props_.find(key);
+        if (it == props_.end()) {
+            throw std::runtime_error("Property '" + key + "' not found");
+        }
+        auto typeIt = types_.find(key);
+        if (typeIt == types_.end() || typeIt->second != std::type_index(typeid(T))) {
+            throw std::runtime_error("Property '" + key + "' type mismatch");
+        }
+        return std::any_cast<T>(it->second);
+    }
+    
+    bool has(const std::string& key) const {
+        return props_.find(key) != props_.end();
+    }
+    
+private:
+    std::unordered_map<std::string, std::any> props_;
+    std::unordered_map<std::string, std::type_index> types_;
+};
+
+constexpr int Iterations = 200000;
+
+template<typename Fn>
+double measureNs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / Iterations;
+}
+
+template<typename P, typename Key>
+void fill(P& props, const Key& x, const Key& y, const Key& width, const Key& height,
+          const Key& color, const Key& fontSize) {
+    props.set(x, 10);
+    props.set(y, 20);
+    props.set(width, 200);
+    props.set(height, 50);
+    props.set(color, uint32_t{0x000000FF});
+    props.set(fontSize, 16);
+}
+
+// One node's worth of renderer reads: rect, color and fontSize
+template<typename P, typename Key>
+int64_t readNode(const P& props, const Key& x, const Key& y, const Key& width, const Key& height,
+                 const Key& color, const Key& fontSize) {
+    int64_t sum = 0;
+    if (props.has(x)) sum += props.template get<int>(x);
+    if (props.has(y)) sum += props.template get<int>(y);
+    if (props.has(width)) sum += props.template get<int>(width);
+    if (props.has(height)) sum += props.template get<int>(height);
+    if (props.has(color)) sum += props.template get<uint32_t>(color);
+    if (props.has(fontSize)) sum += props.template get<int>(fontSize);
+    return sum;
+}
+
+void fillTyped(Props& props) {
+    props.setBuiltin<BuiltinProps::X>(10);
+    props.setBuiltin<BuiltinProps::Y>(20);
+    props.setBuiltin<BuiltinProps::Width>(200);
+    props.setBuiltin<BuiltinProps::Height>(50);
+    props.setBuiltin<BuiltinProps::Color>(0x000000FF);
+    props.setBuiltin<BuiltinProps::FontSize>(16);
+}
+
+// The renderers' read path: plain field loads
+int64_t readTyped(const Props& props) {
+    const BuiltinProps& fields = props.builtins();
+    return int64_t{fields.getOr<BuiltinProps::X>(0)} + fields.getOr<BuiltinProps::Y>(0) +
+           fields.getOr<BuiltinProps::Width>(0) + fields.getOr<BuiltinProps::Height>(0) +
+           fields.getOr<BuiltinProps::Color>(0) + fields.getOr<BuiltinProps::FontSize>(0);
+}
+
+} // namespace
+
+int main() {
+    const std::string sx = "x", sy = "y", sw = "width", sh = "height", sc = "color", sf = "fontSize";
+    volatile int64_t sink = 0;
+    
+    double legacyBuild = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            LegacyProps props;
+            fill(props, sx, sy, sw, sh, sc, sf);
+            sink = sink + props.has(sx);
+        }
+    });
+    double stringBuild = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            Props props;
+            fill(props, sx, sy, sw, sh, sc, sf);
+            sink = sink + props.has(sx);
+        }
+    });
+    double atomBuild = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            Props props;
+            fill(props, keys::x, keys::y, keys::width, keys::height, keys::color, keys::fontSize);
+            sink = sink + props.has(keys::x);
+        }
+    });
+    
+    double typedBuild = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            Props props;
+            fillTyped(props);
+            sink = sink + props.has(keys::x);
+        }
+    });
+    
+    LegacyProps legacy;
+    fill(legacy, sx, sy, sw, sh, sc, sf);
+    Props current;
+    fill(current, keys::x, keys::y, keys::width, keys::height, keys::color, keys::fontSize);
+    
+    double legacyRead = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            sink = sink + readNode(legacy, sx, sy, sw, sh, sc, sf);
+        }
+    });
+    double stringRead = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            sink = sink + readNode(current, sx, sy, sw, sh, sc, sf);
+        }
+    });
+    double atomRead = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            sink = sink + readNode(current, keys::x, keys::y, keys::width, keys::height,
+                                   keys::color, keys::fontSize);
+        }
+    });
+    
+    // Copy of a node's props with a handler, as fibers and component
+    // updates make
+    Props withHandler = current;
+    std::string label(64, 'x');
+    withHandler.set(keys::onClick, std::function<void()>([label] { (void)label; }));
+    double copyProps = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            Props copy = withHandler;
+            sink = sink + copy.size();
+        }
+    });
+    
+    double typedRead = measureNs([&] {
+        for (int i = 0; i < Iterations; ++i) {
+            sink = sink + readTyped(current);
+        }
+    });
+    
+    std::cout << "Props benchmark (" << Iterations << " iterations, ns/op)\n"
+              << "  build 6 props   legacy maps: " << legacyBuild
+              << "  string keys: " << stringBuild
+              << "  atom keys: " << atomBuild
+              << "  typed fields: " << typedBuild << "\n"
+              << "  read node       legacy maps: " << legacyRead
+              << "  string keys: " << stringRead
+              << "  atom keys: " << atomRead
+              << "  typed fields: " << typedRead << "\n"
+              << "  copy 7 props (with handler): " << copyProps << "\n";
+    return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+// Reconciliation benchmark: allocations and time per update for a list of
+// rows whose widths change every render while the shape stays the same.
+// Diffing VNode against VNode builds a fresh fiber tree each time; diffing
+// against the committed fiber tree recycles the alternates.
+#include "reactpp/core/FiberPool.hpp"
+#include "reactpp/core/Reconciler.hpp"
+#include "reactpp/elements/Elements.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace reactpp;
+using namespace reactpp::elements;
+
+namespace {
+size_t allocationCount = 0;
+}
+
+void* operator new(size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr int Rows = 1000;
+constexpr int Updates = 100;
+
+VNode::Ptr buildList(int frame) {
+    std::vector<VNode::Ptr> rows;
+    for (int i = 0; i < Rows; ++i) {
+        auto row = View(props().width(200 + (frame + i) % 50).height(24),
+            Text("Row number " + std::to_string(i)));
+        row->setKey("row" + std::to_string(i));
+        rows.push_back(std::move(row));
+    }
+    return View(Props(), std::move(rows));
+}
+
+// Trees are built up front so only reconciliation is measured
+std::vector<VNode::Ptr> buildFrames() {
+    std::vector<VNode::Ptr> frames;
+    for (int i = 0; i <= Updates + 2; ++i) {
+        frames.push_back(buildList(i));
+        frames.back()->structuralHash();
+    }
+    return frames;
+}
+
+template<typename Update>
+void report(const char* name, Update&& update) {
+    size_t before = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Updates; ++i) {
+        update(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::cout << "  " << name << ": "
+              << static_cast<double>(allocationCount - before) / Updates << " allocs/update, "
+              << std::chrono::duration<double, std::micro>(end - start).count() / Updates << " us/update\n";
+}
+
+} // namespace
+
+int main() {
+    auto frames = buildFrames();
+    std::cout << "Reconcile benchmark (" << Rows << " rows, " << Updates << " updates)\n";
+
+    Reconciler fresh;
+    FiberNode::Ptr result = fresh.reconcile(nullptr, frames[0]);
+    report("VNode diff  ", [&](int i) {
+        result = fresh.reconcile(frames[i], frames[i + 1]);
+    });
+    result.reset();
+
+    // Two warm-up renders fill both buffers
+    Reconciler buffered;
+    FiberNode::Ptr current = buffered.reconcile(nullptr, frames[0]);
+    current = buffered.reconcile(current, frames[1]);
+    current = buffered.reconcile(current, frames[2]);
+    size_t pooled = FiberPool::global().allocated();
+    report("fiber diff  ", [&](int i) {
+        current = buffered.reconcile(current, frames[i + 3]);
+    });
+    std::cout << "  fibers per update: " << buffered.stats().fibers
+              << ", reused: " << buffered.stats().reused
+              << ", pool blocks added: " << FiberPool::global().allocated() - pooled << "\n";
+    return 0;
+}
@@ -0,0 +1,76 @@
+// VNode tree construction benchmark: heap allocation vs. FrameArena.
+// Builds and drops a dashboard-sized tree (~5k nodes) once per frame.
+#include "reactpp/core/FrameArena.hpp"
+#include "reactpp/core/VNode.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace reactpp;
+
+namespace {
+
+constexpr int Frames = 200;
+constexpr int Panels = 50;
+constexpr int RowsPerPanel = 50;
+
+VNode::Ptr buildDashboard() {
+    std::vector<VNode::Ptr> panels;
+    panels.reserve(Panels);
+    for (int p = 0; p < Panels; ++p) {
+        std::vector<VNode::Ptr> rows;
+        rows.reserve(RowsPerPanel);
+        for (int r = 0; r < RowsPerPanel; ++r) {
+            Props props;
+            props.set(keys::y, r * 20);
+            props.set(keys::height, 20);
+            rows.push_back(VNode::createElement("Text", props, {VNode::createText("row")}));
+        }
+        panels.push_back(VNode::createElement("View", Props(), rows));
+    }
+    return VNode::createElement("View", Props(), panels);
+}
+
+size_t countNodes(const VNode::Ptr& node) {
+    size_t count = 1;
+    for (const auto& child : node->getChildren()) {
+        count += countNodes(child);
+    }
+    return count;
+}
+
+template<typename Fn>
+double measureMs(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / Frames;
+}
+
+} // namespace
+
+int main() {
+    size_t nodes = countNodes(buildDashboard());
+    
+    double heapMs = measureMs([] {
+        VNode::Ptr current;
+        for (int frame = 0; frame < Frames; ++frame) {
+            current = buildDashboard();
+        }
+    });
+    
+    FrameArena arena;
+    double arenaMs = measureMs([&arena] {
+        VNode::Ptr current;
+        for (int frame = 0; frame < Frames; ++frame) {
+            arena.beginFrame();
+            FrameArena::Scope scope(arena);
+            current = buildDashboard();
+        }
+    });
+    
+    std::cout << "VNode arena benchmark (" << nodes << " nodes, ms/frame)\n"
+              << "  heap:  " << heapMs << "\n"
+              << "  arena: " << arenaMs << " (" << arena.bytesReserved() / 1024 << " KiB reserved)\n";
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Element construction benchmark: copying factory arguments vs. moving them.
+// Counts heap allocations per node for a list of rows, each a View holding a
+// label and a button, built the way render functions usually build trees,
+// with handles or from a compile-time template, and the allocations a
+// button's onClick costs as a lambda vs. a handle.
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/elements/Elements.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace reactpp;
+using namespace reactpp::elements;
+
+namespace {
+size_t allocationCount = 0;
+}
+
+void* operator new(size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr int Rows = 2000;
+constexpr int Iterations = 50;
+constexpr size_t NodesPerRow = 4;  // View, Text wrapper, text, Button
+
+// Arguments held in named variables and passed as lvalues: every factory
+// copies its Props and children vector
+VNode::Ptr buildCopying() {
+    std::vector<VNode::Ptr> rows;
+    for (int i = 0; i < Rows; ++i) {
+        Props rowProps = props().y(i * 24).height(24);
+        Props labelProps = props().fontSize(14).color(0xFFFFFFFF);
+        std::string label = "Row number " + std::to_string(i);
+        
+        std::vector<VNode::Ptr> children;
+        children.push_back(Text(label, labelProps));
+        Props buttonProps;
+        buttonProps.set(keys::onClick, std::function<void()>([i, label] { (void)i; (void)label; }));
+        children.push_back(Button(buttonProps));
+        
+        rows.push_back(View(rowProps, children));
+    }
+    return View(Props(), rows);
+}
+
+// The same tree built from temporaries and variadic children
+VNode::Ptr buildMoving() {
+    std::vector<VNode::Ptr> rows;
+    for (int i = 0; i < Rows; ++i) {
+        std::string label = "Row number " + std::to_string(i);
+        std::function<void()> onClick = [i, label] { (void)i; (void)label; };
+        
+        rows.push_back(View(props().y(i * 24).height(24),
+            Text(std::move(label), props().fontSize(14).color(0xFFFFFFFF)),
+            Button(std::move(onClick))));
+    }
+    return View(Props(), std::move(rows));
+}
+
+// The moving build with handlers registered once in the handler table:
+// each row passes a stable handle instead of a freshly captured lambda
+std::vector<EventHandle> rowHandlers;
+
+VNode::Ptr buildWithHandles() {
+    std::vector<VNode::Ptr> rows;
+    for (int i = 0; i < Rows; ++i) {
+        rows.push_back(View(props().y(i * 24).height(24),
+            Text("Row number " + std::to_string(i), props().fontSize(14).color(0xFFFFFFFF)),
+            Button(rowHandlers[i])));
+    }
+    return View(Props(), std::move(rows));
+}
+
+// The same rows stamped from a compile-time template: one block per row
+constexpr auto RowTemplate = tmpl::View(tmpl::props().height(24).bind<0>(keys::y),
+    tmpl::Text(tmpl::slot<1>, tmpl::props().fontSize(14).color(0xFFFFFFFF)),
+    tmpl::Button(tmpl::props().bind<2>(keys::onClick)));
+
+VNode::Ptr buildFromTemplate() {
+    static const TreeTemplate row(RowTemplate);
+    std::vector<VNode::Ptr> rows;
+    for (int i = 0; i < Rows; ++i) {
+        rows.push_back(row(i * 24, "Row number " + std::to_string(i), rowHandlers[i]));
+    }
+    return View(Props(), std::move(rows));
+}
+
+// Allocations made by setting the onClick prop alone
+template<typename Handler>
+double handlerPropAllocs(const Handler& handler) {
+    size_t allocations = 0;
+    for (int i = 0; i < Rows; ++i) {
+        Props props;
+        props.set(keys::width, i);
+        size_t before = allocationCount;
+        props.set(keys::onClick, handler);
+        allocations += allocationCount - before;
+    }
+    return static_cast<double>(allocations) / Rows;
+}
+
+template<typename Build>
+void report(const char* name, Build&& build) {
+    size_t before = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < Iterations; ++i) {
+        build();
+    }
+    auto end = std::chrono::steady_clock::now();
+    
+    double nodes = static_cast<double>(Iterations) * Rows * NodesPerRow;
+    std::cout << "  " << name << ": "
+              << (allocationCount - before) / nodes << " allocs/node, "
+              << std::chrono::duration<double, std::nano>(end - start).count() / nodes << " ns/node\n";
+}
+
+} // namespace
+
+int main() {
+    std::cout << "VNode build benchmark (" << Rows * NodesPerRow << " nodes)\n";
+    report("copying", buildCopying);
+    report("moving ", buildMoving);
+    
+    for (int i = 0; i < Rows; ++i) {
+        rowHandlers.push_back(HandlerTable::global().add([i] { (void)i; }));
+    }
+    report("handles", buildWithHandles);
+    report("template", buildFromTemplate);
+    
+    std::string label = "Row number 0";
+    std::cout << "  onClick prop allocs   lambda: "
+              << handlerPropAllocs(std::function<void()>([label] { (void)label; }))
+              << "  handle: " << handlerPropAllocs(rowHandlers[0]) << "\n";
+    return 0;
+}
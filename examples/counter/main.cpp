@@ -16,9 +16,17 @@ using reactpp::elements::props;
 class Counter : public Component {
 private:
     int count_;
+    EventHandle increment_;
 
 public:
-    Counter() : count_(0) {}
+    Counter() : count_(0) {
+        // Registered once; render() passes the same handle every frame
+        increment_ = addHandler([this]() {
+            std::cout << "Button clicked" << std::endl;
+            count_++;
+            std::cout << "Count: " << count_ << std::endl;
+        });
+    }
     
     VNode::Ptr render() override {
         using namespace reactpp::renderer;
@@ -37,17 +45,14 @@ public:
                 ),
                 Button(
                     props()
-                        .onClick([this]() {
-                            std::cout << "Button clicked" << std::endl;
-                            count_++;
-                            std::cout << "Count: " << count_ << std::endl;
-                        })
+                        .onClick(increment_)
                         .x(300)
                         .y(300)
                         .width(200)
                         .height(50),
                     {
-                        Text("Increment")
+                        // Static label: built once, reused every render
+                        hoisted(0, [] { return Text("Increment"); })
                     }
                 )
             }
@@ -91,6 +96,7 @@ int main(int argc, char* argv[]) {
         
         bool running = true;
         bool needsRender = true;
+        FrameArena frameArena; // Must outlive currentVNode
         VNode::Ptr currentVNode = nullptr;
         
 #ifdef __linux__
@@ -110,7 +116,11 @@ int main(int argc, char* argv[]) {
             // Framebuffer mode: render once and exit (or implement input handling separately)
             while (running) {
                 if (needsRender || !currentVNode) {
-                    currentVNode = component->render();
+                    frameArena.beginFrame();
+                    {
+                        FrameArena::Scope arenaScope(frameArena);
+                        currentVNode = component->render();
+                    }
                     
                     fbRenderer->clear(fbRenderer->rgb(240, 240, 240));
                     fbRenderer->render(currentVNode);
@@ -142,7 +152,11 @@ int main(int argc, char* argv[]) {
             while (running) {
                 // Render first to build layout cache
                 if (needsRender || !currentVNode) {
-                    currentVNode = component->render();
+                    frameArena.beginFrame();
+                    {
+                        FrameArena::Scope arenaScope(frameArena);
+                        currentVNode = component->render();
+                    }
                     
                     sdlRenderer->clear(sdlRenderer->rgb(240, 240, 240));
                     sdlRenderer->render(currentVNode);
@@ -12,22 +12,29 @@ class TodoApp : public Component {
 private:
     std::vector<std::string> todos_;
     std::string inputText_;
+    EventHandle onInput_;
+    EventHandle onAdd_;
 
 public:
-    VNode::Ptr render() override {
-        Props inputProps;
-        inputProps.set("value", inputText_);
-        inputProps.set("onChange", [this](const std::string& value) {
+    TodoApp() {
+        onInput_ = addHandler([this](const std::string& value) {
             inputText_ = value;
         });
-        
-        Props addButtonProps;
-        addButtonProps.set("onClick", [this]() {
+        onAdd_ = addHandler([this]() {
             if (!inputText_.empty()) {
                 todos_.push_back(inputText_);
                 inputText_.clear();
             }
         });
+    }
+    
+    VNode::Ptr render() override {
+        Props inputProps;
+        inputProps.set("value", inputText_);
+        inputProps.set("onChange", onInput_);
+        
+        Props addButtonProps;
+        addButtonProps.set("onClick", onAdd_);
         
         std::vector<VNode::Ptr> todoNodes;
         for (const auto& todo : todos_) {
@@ -6,8 +6,12 @@
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
 #include "reactpp/core/Component.hpp"
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
 #include "reactpp/core/ComponentInstance.hpp"
 #include "reactpp/core/FiberNode.hpp"
+#include "reactpp/core/FrameArena.hpp"
+#include "reactpp/core/VNodeSerializer.hpp"
 
 // Elements
 #include "reactpp/elements/Elements.hpp"
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "PropKey.hpp"
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+namespace reactpp {
+
+// Typed storage for the geometry and style props of the built-in elements.
+//
+// Props keeps these fields here instead of in its std::any entries when they
+// are set with their native type (int, or uint32_t for colors), so renderers
+// read them as plain struct members. Each field maps to the well-known key
+// with the same name; `present` records which fields are set.
+struct BuiltinProps {
+    enum Field : uint8_t {
+        X,
+        Y,
+        Width,
+        Height,
+        BackgroundColor,
+        BorderColor,
+        Color,
+        FontSize,
+        BorderWidth,
+        FieldCount
+    };
+
+    // Value type of a field
+    template<Field F>
+    using Type = std::conditional_t<F == BackgroundColor || F == BorderColor || F == Color, uint32_t, int>;
+
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+    uint32_t backgroundColor = 0;
+    uint32_t borderColor = 0;
+    uint32_t color = 0;
+    int fontSize = 0;
+    int borderWidth = 0;
+    uint16_t present = 0;
+
+    constexpr bool has(Field field) const { return present & (1u << field); }
+    constexpr bool empty() const { return present == 0; }
+    size_t size() const { return static_cast<size_t>(__builtin_popcount(present)); }
+    constexpr void clear(Field field) { present &= static_cast<uint16_t>(~(1u << field)); }
+
+    // Field value, or fallback if it is not set
+    template<Field F>
+    constexpr Type<F> getOr(Type<F> fallback) const {
+        return has(F) ? *slot<Type<F>>(F) : fallback;
+    }
+
+    template<Field F>
+    constexpr void set(Type<F> value) {
+        *slot<Type<F>>(F) = value;
+        present |= static_cast<uint16_t>(1u << F);
+    }
+
+    // Store value if T is the field's value type; false otherwise
+    template<typename T>
+    bool assign(Field field, T value) {
+        T* target = slot<T>(field);
+        if (!target) {
+            return false;
+        }
+        *target = value;
+        present |= static_cast<uint16_t>(1u << field);
+        return true;
+    }
+
+    // Copy one field (set or not) from other
+    void copyField(const BuiltinProps& other, Field field) {
+        if (!other.has(field)) {
+            clear(field);
+        } else if (isColor(field)) {
+            assign(field, *other.slot<uint32_t>(field));
+        } else {
+            assign(field, *other.slot<int>(field));
+        }
+    }
+
+    // Keys of the fields share their order (keys::x is field X, ...)
+    static constexpr PropKey keyOf(Field field) { return PropKey(field + 1); }
+    static constexpr std::optional<Field> fieldOf(PropKey key) {
+        if (key.id() >= 1 && key.id() <= FieldCount) {
+            return static_cast<Field>(key.id() - 1);
+        }
+        return std::nullopt;
+    }
+
+    static constexpr bool isColor(Field field) {
+        return field == BackgroundColor || field == BorderColor || field == Color;
+    }
+
+    // Storage of a field if T is its value type, else nullptr
+    template<typename T>
+    constexpr T* slot(Field field) {
+        return const_cast<T*>(static_cast<const BuiltinProps*>(this)->slot<T>(field));
+    }
+
+    template<typename T>
+    constexpr const T* slot(Field field) const {
+        if constexpr (std::is_same_v<T, int>) {
+            switch (field) {
+                case X: return &x;
+                case Y: return &y;
+                case Width: return &width;
+                case Height: return &height;
+                case FontSize: return &fontSize;
+                case BorderWidth: return &borderWidth;
+                default: return nullptr;
+            }
+        } else if constexpr (std::is_same_v<T, uint32_t>) {
+            switch (field) {
+                case BackgroundColor: return &backgroundColor;
+                case BorderColor: return &borderColor;
+                case Color: return &color;
+                default: return nullptr;
+            }
+        } else {
+            (void)field;
+            return nullptr;
+        }
+    }
+
+    // Same fields set to the same values
+    bool operator==(const BuiltinProps& other) const {
+        if (present != other.present) {
+            return false;
+        }
+        for (uint8_t i = 0; i < FieldCount; ++i) {
+            auto field = static_cast<Field>(i);
+            if (has(field) && raw(field) != other.raw(field)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const BuiltinProps& other) const { return !(*this == other); }
+
+    // Field value as raw bits, for comparing and hashing
+    uint32_t raw(Field field) const {
+        if (isColor(field)) {
+            return *slot<uint32_t>(field);
+        }
+        return static_cast<uint32_t>(*slot<int>(field));
+    }
+};
+
+} // namespace reactpp
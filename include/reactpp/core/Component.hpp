@@ -2,9 +2,14 @@
 
 #include "VNode.hpp"
 #include "Props.hpp"
+#include "HandlerTable.hpp"
+#include "FrameArena.hpp"
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <atomic>
+#include <vector>
 
 namespace reactpp {
 
@@ -15,7 +20,11 @@ public:
     using Ptr = std::shared_ptr<Component>;
     
     Component();
-    virtual ~Component() = default;
+    virtual ~Component();
+    
+    // Handler registrations are owned, so components are not copyable
+    Component(const Component&) = delete;
+    Component& operator=(const Component&) = delete;
     
     // Pure virtual render method
     virtual VNode::Ptr render() = 0;
@@ -26,6 +35,14 @@ public:
     virtual void onUpdate(const Props& oldProps, const Props& newProps) {}
     virtual void onUnmount() {}
     
+    // Whether newProps would render the same as oldProps. When it returns
+    // true and the hook manager is clean, the reconciler reuses the previous
+    // output instead of calling render(). Compares every prop by default;
+    // see memo() for a custom comparison.
+    virtual bool propsEqual(const Props& oldProps, const Props& newProps) const {
+        return oldProps == newProps;
+    }
+    
     // Props access
     const Props& getProps() const { return props_; }
     Props& getProps() { return props_; }
@@ -35,6 +52,40 @@ public:
     std::shared_ptr<HookManager> getHookManager() const { return hookManager_; }
     void setHookManager(std::shared_ptr<HookManager> manager) { hookManager_ = manager; }
     
+    // Register an event handler in HandlerTable::global() for the lifetime of
+    // this component. Register once (e.g. in the constructor) and pass the
+    // handle in props on every render: the handle compares equal across
+    // renders and setting it allocates nothing.
+    EventHandle addHandler(HandlerTable::ClickHandler handler);
+    EventHandle addHandler(HandlerTable::ChangeHandler handler);
+    
+    // Static subtree for a slot of this component's render output. Opt-in:
+    // build must not depend on state, props or anything else that changes
+    // between renders, since its first result is reused for the lifetime
+    // of the component. VNode::isStatic only rules out what it can see
+    // (component nodes and event handlers); such results are rebuilt every
+    // time. build runs outside any bound FrameArena, so a hoisted subtree
+    // does not pin an arena frame.
+    template<typename Build>
+    VNode::Ptr hoisted(size_t slot, Build&& build) {
+        if (slot < hoisted_.size() && hoisted_[slot]) {
+            return hoisted_[slot];
+        }
+        VNode::Ptr node;
+        {
+            FrameArena::Suspend heap;
+            node = build();
+        }
+        if (!node || !node->isStatic()) {
+            return node;
+        }
+        if (slot >= hoisted_.size()) {
+            hoisted_.resize(slot + 1);
+        }
+        hoisted_[slot] = VNode::hoist(std::move(node));
+        return hoisted_[slot];
+    }
+    
     // Component ID
     uint64_t getId() const { return id_; }
     
@@ -50,7 +101,36 @@ private:
     uint64_t id_;
     std::string displayName_;
     std::shared_ptr<HookManager> hookManager_;
+    std::vector<EventHandle> handlers_;
+    std::vector<VNode::Ptr> hoisted_;
 };
 
+// Base with its props compared by equal (see Component::propsEqual)
+template<typename Base, typename Equal>
+class Memo : public Base {
+public:
+    template<typename... Args>
+    explicit Memo(Equal equal, Args&&... args)
+        : Base(std::forward<Args>(args)...), equal_(std::move(equal)) {}
+    
+    bool propsEqual(const Props& oldProps, const Props& newProps) const override {
+        return equal_(oldProps, newProps);
+    }
+    
+private:
+    Equal equal_;
+};
+
+// Component of type Base, constructed from args, that re-renders only when
+// equal(oldProps, newProps) is false or its hooks are dirty:
+//   auto row = memo<Row>([](const Props& a, const Props& b) {
+//       return a.get<int>("id") == b.get<int>("id");
+//   });
+template<typename Base, typename Equal, typename... Args>
+std::shared_ptr<Base> memo(Equal equal, Args&&... args) {
+    return std::make_shared<Memo<Base, std::decay_t<Equal>>>(
+        std::forward<Equal>(equal), std::forward<Args>(args)...);
+}
+
 } // namespace reactpp
 
@@ -2,19 +2,34 @@
 
 #include "VNode.hpp"
 #include "Component.hpp"
+#include <any>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <optional>
 
 namespace reactpp {
 
-enum class EffectTag {
-    None,
-    Placement,  // Insert new node
-    Update,     // Update existing node
-    Deletion    // Remove node
+// Flags: a moved node whose props also changed is Placement | Update
+enum class EffectTag : uint8_t {
+    None = 0,
+    Placement = 1 << 0,  // Insert new node, or move an existing one
+    Update = 1 << 1,     // Update existing node
+    Deletion = 1 << 2    // Remove node
 };
 
+constexpr EffectTag operator|(EffectTag a, EffectTag b) {
+    return static_cast<EffectTag>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
+}
+
+constexpr EffectTag operator&(EffectTag a, EffectTag b) {
+    return static_cast<EffectTag>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b));
+}
+
+constexpr bool hasEffect(EffectTag tags, EffectTag effect) {
+    return (tags & effect) != EffectTag::None;
+}
+
 enum class Priority {
     Immediate,
     UserBlocking,
@@ -34,10 +49,18 @@ public:
     std::any stateNode;
     
     // Tree structure
-    Ptr return_;  // Parent fiber
+    // Parent fiber; not owning, so trees have no cycles. Children that a
+    // skipped subtree or a component bailout shares between the two trees
+    // point at their parent in the last committed tree (see
+    // Reconciler::commit).
+    FiberNode* return_;
     Ptr child;    // First child fiber
     Ptr sibling;  // Next sibling fiber
-    Ptr alternate; // Alternate fiber for double-buffering
+    // Double buffering: a work-in-progress fiber's alternate is the current
+    // fiber it replaces, and a current fiber's alternate is the fiber from
+    // the render before, recycled for the next one (see Reconciler). Only
+    // one of the pair points at the other, so there are no cycles.
+    Ptr alternate;
     
     // Work tags
     EffectTag effectTag;
@@ -57,18 +80,28 @@ public:
     // Reference to VNode
     VNode::Ptr vnode;
     
-    // Component reference
+    // Component reference: the instance this fiber rendered
     std::shared_ptr<Component> component;
+    // Some fiber below this one is a component, so the reconciler walks the
+    // subtree instead of skipping it (see Reconciler)
+    bool hasComponents;
     
     FiberNode();
+    // Allocated from FiberPool::global()
     static Ptr create(VNode::Ptr vnode);
     
+    // Reuse this fiber for vnode: links, alternate and effects are cleared.
+    // Props are shared with the node, not copied.
+    void reset(VNode::Ptr vnode);
+    
     // Tree operations
     void appendChild(Ptr child);
     Ptr findChildByKey(const std::string& key) const;
     
     // Work phase helpers
     void markForUpdate(EffectTag tag);
+    void addEffect(EffectTag tag) { effectTag = effectTag | tag; }
+    bool hasEffect(EffectTag tag) const { return reactpp::hasEffect(effectTag, tag); }
     void addToEffectList(Ptr fiber);
 };
 
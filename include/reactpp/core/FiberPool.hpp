@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+
+namespace reactpp {
+
+// Free list of fiber allocations.
+//
+// FiberNode::create places each fiber and its shared_ptr control block in
+// one block from the global pool; a released fiber's block goes back on the
+// list and is handed to the next fiber instead of returning to the heap.
+// Every block has the size of the first request; other sizes, and
+// over-aligned requests, go to the default resource.
+class FiberPool : public std::pmr::memory_resource {
+public:
+    // Pool used by FiberNode::create. Never destroyed, so fibers may outlive
+    // static objects.
+    static FiberPool& global();
+
+    FiberPool() = default;
+    ~FiberPool() override;
+
+    FiberPool(const FiberPool&) = delete;
+    FiberPool& operator=(const FiberPool&) = delete;
+
+    // Blocks taken from the heap so far
+    size_t allocated() const;
+    // Released blocks waiting for reuse
+    size_t available() const;
+
+    // Return the available blocks to the heap
+    void trim();
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    // Intrusive: a free block holds the link to the next one
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    bool pooled(size_t bytes, size_t alignment) const;
+
+    mutable std::mutex mutex_;
+    size_t blockSize_ = 0;
+    FreeBlock* free_ = nullptr;
+    size_t allocated_ = 0;
+    size_t available_ = 0;
+};
+
+} // namespace reactpp
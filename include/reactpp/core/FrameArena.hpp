@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace reactpp {
+
+// Double-buffered bump allocator for per-frame VNode trees.
+//
+// While a FrameArena::Scope is active on a thread, VNode factories place the
+// node, its shared_ptr control block and its children array in the arena.
+// Deallocation is bookkeeping only; memory is reclaimed a whole frame at a
+// time. The arena keeps two frames: the tree being built and the previous
+// one (still needed for diffing). beginFrame() recycles the frame before
+// that, which must no longer be referenced.
+//
+// Not thread-safe: use one arena per thread.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DefaultBlockSize = 64 * 1024;
+
+    explicit FrameArena(size_t blockSize = DefaultBlockSize);
+    ~FrameArena() override;  // Aborts if allocations are still alive
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Start a new frame, recycling the memory of the frame before the previous
+    // one. Throws if allocations from that frame are still alive.
+    void beginFrame();
+
+    // Release both frames (all allocations must be dead)
+    void reset();
+
+    // Statistics
+    size_t bytesUsed() const;
+    size_t bytesReserved() const;
+    size_t liveAllocations() const;
+
+    // Binds an arena to the current thread for the lifetime of the scope
+    class Scope {
+    public:
+        explicit Scope(FrameArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        FrameArena* previous_;
+    };
+
+    // Unbinds the current thread's arena for the lifetime of the scope, so
+    // nodes built in it come from the heap and may outlive the frame
+    class Suspend {
+    public:
+        Suspend();
+        ~Suspend();
+
+        Suspend(const Suspend&) = delete;
+        Suspend& operator=(const Suspend&) = delete;
+
+    private:
+        FrameArena* previous_;
+    };
+
+    // Arena bound to the current thread, or nullptr
+    static FrameArena* current();
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+    };
+
+    struct Pool {
+        std::vector<Block> blocks;
+        size_t blockIndex = 0;  // Block currently being bumped
+        size_t offset = 0;      // Offset into that block
+        size_t used = 0;
+        size_t live = 0;        // Allocations not yet deallocated
+    };
+
+    void rewind(Pool& pool);
+    void freeBlocks(Pool& pool);
+    Pool* owningPool(const void* p);
+
+    size_t blockSize_;
+    Pool pools_[2];
+    int active_;
+};
+
+} // namespace reactpp
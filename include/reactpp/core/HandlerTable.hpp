@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace reactpp {
+
+// Small, trivially copyable reference to a handler in a HandlerTable.
+//
+// Stored in Props (under keys::onClick, keys::onChange, ...) in place of a
+// std::function. A handle fits std::any's inline buffer, so setting it
+// allocates nothing, and it compares equal to itself across renders, so a
+// node whose only change is a re-created handler no longer looks changed.
+struct EventHandle {
+    uint32_t slot = 0;        // 1-based; 0 is the empty handle
+    uint32_t generation = 0;  // Bumped when the slot is released
+
+    bool valid() const { return slot != 0; }
+    explicit operator bool() const { return valid(); }
+
+    bool operator==(const EventHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const EventHandle& other) const { return !(*this == other); }
+};
+
+// Registry of event handlers addressed by stable EventHandles.
+//
+// Components register their handlers once (see Component::addHandler) and
+// pass the handles in props on every render; renderers resolve a handle when
+// the event is dispatched. Released slots are recycled, and a handle to a
+// released slot is stale: invoking it does nothing.
+//
+// Not thread-safe: register, release and dispatch on the UI thread.
+class HandlerTable {
+public:
+    using ClickHandler = std::function<void()>;
+    using ChangeHandler = std::function<void(const std::string&)>;
+
+    // Table shared by components and renderers
+    static HandlerTable& global();
+
+    EventHandle add(ClickHandler handler);
+    EventHandle add(ChangeHandler handler);
+
+    // Swap the function behind a live handle; the handle stays the same.
+    // Returns false if the handle is stale. Called from inside a handler,
+    // the swap takes effect once dispatch returns.
+    bool replace(EventHandle handle, ClickHandler handler);
+    bool replace(EventHandle handle, ChangeHandler handler);
+
+    // Free the slot. Safe to call from inside a handler, including the one
+    // being released; releasing a stale handle does nothing.
+    void release(EventHandle handle);
+
+    bool contains(EventHandle handle) const;
+
+    // Call the handler. Returns false if the handle is stale or refers to a
+    // handler of the other signature.
+    bool invoke(EventHandle handle);
+    bool invoke(EventHandle handle, const std::string& value);
+
+    // Number of live handlers
+    size_t size() const { return live_; }
+
+private:
+    using Handler = std::variant<std::monostate, ClickHandler, ChangeHandler>;
+
+    struct Slot {
+        Handler handler;
+        uint32_t generation = 1;
+    };
+
+    // Returns null for stale handles
+    Slot* find(EventHandle handle);
+    const Slot* find(EventHandle handle) const;
+
+    EventHandle insert(Handler handler);
+    bool assign(EventHandle handle, Handler handler);
+    void finishDispatch();
+
+    // A deque keeps slots in place while a running handler adds new ones
+    std::deque<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    // Slots released while a handler was running; emptied afterwards so the
+    // running function is not destroyed under itself
+    std::vector<uint32_t> pendingFree_;
+    std::vector<std::pair<uint32_t, Handler>> pendingReplace_;
+    size_t live_ = 0;
+    int dispatchDepth_ = 0;
+};
+
+} // namespace reactpp
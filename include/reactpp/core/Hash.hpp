@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reactpp {
+
+// Finalizer from splitmix64; spreads small integers over the full range
+inline uint64_t hashMix(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xbf58476d1ce4e5b9ULL;
+    value ^= value >> 27;
+    value *= 0x94d049bb133111ebULL;
+    value ^= value >> 31;
+    return value;
+}
+
+// Order-dependent combine (from boost::hash_combine, widened to 64 bits)
+inline uint64_t hashCombine(uint64_t seed, uint64_t value) {
+    return seed ^ (hashMix(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
+} // namespace reactpp
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "VNode.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// Column numbers are used where the compiler can report them; elsewhere two
+// factory calls on one line share a site and are told apart by their
+// position among same-site siblings
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_COLUMN)
+#define REACTPP_CALL_COLUMN() __builtin_COLUMN()
+#endif
+#endif
+#ifndef REACTPP_CALL_COLUMN
+#define REACTPP_CALL_COLUMN() 0u
+#endif
+
+namespace reactpp {
+
+// Source location of a call. CallSite::current() as a default argument
+// records the caller's location.
+struct CallSite {
+    const char* file = "";
+    uint32_t line = 0;
+    uint32_t column = 0;
+
+    static constexpr CallSite current(
+        const char* file = __builtin_FILE(),
+        uint32_t line = __builtin_LINE(),
+        uint32_t column = REACTPP_CALL_COLUMN()) {
+        return CallSite{file, line, column};
+    }
+};
+
+// Opt-in keys derived from where an element factory was called.
+//
+// While enabled, the element factories (View, Text, Button, Input) tag each
+// node with a key for its call site. Siblings created at the same site (a
+// loop) are numbered in order when they are attached to their parent, so a
+// list item's implicit key is its site plus its loop index. Stable ids use
+// the implicit key in place of the child index when no explicit key is set,
+// so inserting or removing a conditional sibling no longer shifts the ids of
+// the nodes after it, and their cached layout and styles are kept.
+//
+// Keys are only stable within a process (the file name is hashed by
+// address). An explicit key always wins.
+class ImplicitKeys {
+public:
+    static void setEnabled(bool enabled);
+    static bool enabled();
+
+    // Key for a factory call at the site; 0 while disabled
+    static uint64_t forSite(const CallSite& site);
+
+    // Enables implicit keys for its lifetime, restoring the previous setting
+    class Scope {
+    public:
+        explicit Scope(bool enable = true) : previous_(enabled()) { setEnabled(enable); }
+        ~Scope() { setEnabled(previous_); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool previous_;
+    };
+};
+
+// Factory argument that also records where the factory was called. Converts
+// implicitly from anything convertible to T, so callers pass T as before.
+template<typename T>
+struct WithSite {
+    T value;
+    CallSite site;
+
+    WithSite(CallSite site = CallSite::current()) : value(), site(site) {}
+
+    template<typename U, typename = std::enable_if_t<
+        std::is_convertible_v<U, T> && !std::is_same_v<std::decay_t<U>, WithSite>>>
+    WithSite(U&& value, CallSite site = CallSite::current())
+        : value(std::forward<U>(value)), site(site) {}
+
+    // Tags the node with this site's implicit key (if enabled)
+    VNode::Ptr keyed(VNode::Ptr node) const {
+        if (uint64_t key = ImplicitKeys::forSite(site)) {
+            node->setImplicitKey(key);
+        }
+        return node;
+    }
+};
+
+} // namespace reactpp
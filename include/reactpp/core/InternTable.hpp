@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace reactpp {
+
+// Thread-safe string interner mapping names to small dense ids.
+// Id 0 is reserved as "invalid"; predefined names get ids 1..N in order.
+class InternTable {
+public:
+    static constexpr uint32_t InvalidId = 0;
+    
+    InternTable(std::initializer_list<const char*> predefined = {});
+    
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+    
+    // Get the id for a name, adding it if needed
+    uint32_t intern(std::string_view name);
+    
+    // Get the id for a name without adding it (InvalidId if unknown)
+    uint32_t find(std::string_view name) const;
+    
+    // Get the name for an id (empty string for unknown ids)
+    const std::string& name(uint32_t id) const;
+    
+    // Number of interned names
+    size_t size() const;
+    
+private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, uint32_t> ids_; // Views into names_
+    std::deque<std::string> names_;                      // Stable storage, index = id - 1
+};
+
+} // namespace reactpp
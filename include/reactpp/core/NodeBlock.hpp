@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+
+namespace reactpp {
+
+// Single pre-sized allocation holding the nodes of one tree.
+//
+// While a NodeBlock::Scope is active on a thread, VNode factories place the
+// node, its shared_ptr control block and its children array in the block
+// (ahead of any bound FrameArena). Allocations bump through the block;
+// requests that don't fit go to the default resource. The block lives in
+// the same allocation as its own header and frees itself once its creator
+// has released it and every allocation from it is gone, so trees built in
+// it can be kept and shared like any other.
+//
+// Building is single-threaded; nodes may be released from any thread.
+class NodeBlock : public std::pmr::memory_resource {
+public:
+    // New block with room for capacity bytes of nodes
+    static NodeBlock* create(size_t capacity);
+
+    NodeBlock(const NodeBlock&) = delete;
+    NodeBlock& operator=(const NodeBlock&) = delete;
+
+    // Drop the creator's reference. Call when done building.
+    void release();
+
+    size_t capacity() const { return capacity_; }
+    // Bytes requested so far, including requests that did not fit; a block
+    // of this capacity would have held them all
+    size_t bytesRequested() const { return requested_; }
+
+    // Binds a block to the current thread for the lifetime of the scope
+    class Scope {
+    public:
+        explicit Scope(NodeBlock& block);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        NodeBlock* previous_;
+    };
+
+    // Block bound to the current thread, or nullptr
+    static NodeBlock* current();
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    explicit NodeBlock(size_t capacity);
+    ~NodeBlock() override = default;
+
+    void unref();
+
+    char* data_;
+    size_t capacity_;
+    size_t offset_ = 0;
+    size_t requested_ = 0;
+    std::atomic<size_t> refs_{1};  // Live allocations plus the creator
+};
+
+} // namespace reactpp
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "VNode.hpp"
+#include "FrameArena.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace reactpp {
+
+// Builds independent subtrees (e.g. one per dashboard panel) in parallel.
+//
+// Each thread allocates node ids from its own block and, if enabled, nodes
+// from its own FrameArena, so workers don't contend on shared state. The
+// returned subtrees are detached; splice them into the tree on the calling
+// thread with VNode::appendChildren.
+//
+// Arena-backed subtrees follow FrameArena rules: call beginFrame() once per
+// frame, and release subtrees only from the thread that calls build(), never
+// while a build is running. Splicing does not move them out of their arena:
+// a spliced node's children vector still grows in the worker's arena, so
+// don't add or remove children of nodes built by a worker while a build is
+// running.
+class ParallelBuilder {
+public:
+    using BuildFn = std::function<VNode::Ptr(size_t index)>;
+    
+    // threadCount includes the calling thread; 0 uses the hardware concurrency
+    explicit ParallelBuilder(size_t threadCount = 0, bool useArenas = true);
+    ~ParallelBuilder();
+    
+    ParallelBuilder(const ParallelBuilder&) = delete;
+    ParallelBuilder& operator=(const ParallelBuilder&) = delete;
+    
+    // Start a new frame on every per-thread arena
+    void beginFrame();
+    
+    // Call build(i) for every i in [0, count) across the worker threads and
+    // the calling thread. Returns the subtrees in index order. Rethrows the
+    // first exception thrown by build.
+    std::vector<VNode::Ptr> build(size_t count, const BuildFn& build);
+    
+    size_t threadCount() const { return threads_.size() + 1; }
+    
+private:
+    void workerLoop(size_t worker);
+    void runJobs(size_t worker);
+    
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<FrameArena>> arenas_;  // Per thread; [0] is the caller's
+    
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    uint64_t generation_;
+    size_t running_;
+    bool stopping_;
+    
+    // Current job
+    const BuildFn* job_;
+    size_t jobCount_;
+    std::atomic<size_t> nextIndex_;
+    std::vector<VNode::Ptr>* results_;
+    std::exception_ptr error_;
+};
+
+} // namespace reactpp
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <any>
+#include <cstdint>
+#include <functional>
+#include <typeindex>
+#include <type_traits>
+
+namespace reactpp {
+
+// Registry of per-type value comparison and hashing used by Props equality
+// and Props::hash().
+//
+// Built in: int, uint32_t, float, double, bool, std::string,
+// std::vector<renderer::GradientStop>, and identity comparison for
+// std::function<void()> / std::function<void(const std::string&)> handlers,
+// and EventHandle by value.
+// Values of unregistered types only compare equal to themselves, so
+// memoization on them is conservative rather than wrong.
+// Registered functions run without the registry lock held, so they may
+// compare props or register types themselves. Lookups are cached per
+// thread until the registry changes.
+class PropComparators {
+public:
+    using EqualFn = std::function<bool(const std::any&, const std::any&)>;
+    using HashFn = std::function<uint64_t(const std::any&)>;
+    
+    // Register a type using its operator== (and std::hash, if available)
+    template<typename T>
+    static void registerType() {
+        registerType<T>([](const T& a, const T& b) { return a == b; });
+    }
+    
+    // Register a type with a custom comparator and optional hash
+    template<typename T>
+    static void registerType(std::function<bool(const T&, const T&)> equal,
+                             std::function<uint64_t(const T&)> hash = {}) {
+        HashFn erasedHash;
+        if (hash) {
+            erasedHash = [hash](const std::any& value) {
+                return hash(*std::any_cast<T>(&value));
+            };
+        } else if constexpr (std::is_default_constructible_v<std::hash<T>>) {
+            erasedHash = [](const std::any& value) -> uint64_t {
+                return std::hash<T>{}(*std::any_cast<T>(&value));
+            };
+        }
+        
+        registerErased(std::type_index(typeid(T)),
+            [equal](const std::any& a, const std::any& b) {
+                return equal(*std::any_cast<T>(&a), *std::any_cast<T>(&b));
+            },
+            std::move(erasedHash));
+    }
+    
+    // Remove a registration
+    static void unregisterType(std::type_index type);
+    
+    static bool isRegistered(std::type_index type);
+    
+    // True for the event handler types above. Handlers don't affect how a
+    // node paints, so Props::visuallyEquals() and visualHash() skip them.
+    static bool isHandler(std::type_index type);
+    
+    // Compare two values already known to hold `type`
+    static bool equal(std::type_index type, const std::any& a, const std::any& b);
+    
+    // True if `type` has a registered hash
+    static bool isHashable(std::type_index type);
+    
+    // Hash a value of `type` (0 if the type has no registered hash)
+    static uint64_t hash(std::type_index type, const std::any& value);
+    
+private:
+    static void registerErased(std::type_index type, EqualFn equal, HashFn hash);
+};
+
+} // namespace reactpp
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "InternTable.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace reactpp {
+
+// Interned property name. Comparing and hashing keys is a single integer
+// operation; the string is only touched when a key is first resolved.
+class PropKey {
+public:
+    constexpr PropKey() : id_(InternTable::InvalidId) {}
+    constexpr explicit PropKey(uint32_t id) : id_(id) {}
+    explicit PropKey(std::string_view name) : id_(intern(name).id_) {}
+    
+    // Resolve a name, adding it to the key table if needed
+    static PropKey intern(std::string_view name);
+    
+    // Resolve a name without adding it (invalid key if never interned)
+    static PropKey find(std::string_view name);
+    
+    constexpr uint32_t id() const { return id_; }
+    constexpr bool valid() const { return id_ != InternTable::InvalidId; }
+    const std::string& name() const { return table().name(id_); }
+    
+    constexpr bool operator==(PropKey other) const { return id_ == other.id_; }
+    constexpr bool operator!=(PropKey other) const { return id_ != other.id_; }
+    constexpr bool operator<(PropKey other) const { return id_ < other.id_; }
+    
+private:
+    static InternTable& table();
+    
+    uint32_t id_;
+};
+
+// Well-known keys used by the built-in elements and renderers.
+// Ids are fixed: PropKey::table() pre-interns these names in this order.
+namespace keys {
+    constexpr PropKey x{1};
+    constexpr PropKey y{2};
+    constexpr PropKey width{3};
+    constexpr PropKey height{4};
+    constexpr PropKey backgroundColor{5};
+    constexpr PropKey borderColor{6};
+    constexpr PropKey color{7};
+    constexpr PropKey fontSize{8};
+    constexpr PropKey borderWidth{9};
+    constexpr PropKey gradient{10};
+    constexpr PropKey gradientDirection{11};
+    constexpr PropKey onClick{12};
+    constexpr PropKey onChange{13};
+    constexpr PropKey value{14};
+} // namespace keys
+
+} // namespace reactpp
+
+namespace std {
+template<>
+struct hash<reactpp::PropKey> {
+    size_t operator()(reactpp::PropKey key) const noexcept {
+        return std::hash<uint32_t>{}(key.id());
+    }
+};
+} // namespace std
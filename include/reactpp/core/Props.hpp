@@ -1,149 +1,531 @@
 #pragma once
 
-#include <unordered_map>
+#include "BuiltinProps.hpp"
+#include "PropKey.hpp"
+#include "PropComparators.hpp"
+#include "SmallVector.hpp"
 #include <any>
 #include <typeindex>
 #include <string>
+#include <string_view>
 #include <optional>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace reactpp {
 
+// Property bag of a VNode.
+//
+// The built-in geometry and style keys (keys::x through keys::borderWidth)
+// set with their native type live in a typed BuiltinProps struct; every
+// other key, or a built-in key set with another type (e.g. a "#RRGGBB"
+// color string), lives in a small vector of std::any entries. The keyed
+// API, size() and iteration cover both.
+//
+// Both stores sit in one reference-counted block shared by copies: copying
+// Props costs a refcount, and the first write to a shared block clones it
+// (copy-on-write). Copies that were never written to still share their
+// block, which sharesStorageWith() reports in O(1). Like a node, the block
+// comes from the thread's NodeBlock or FrameArena if one is bound, so
+// Props written during an arena frame live no longer than the frame. Not
+// thread-safe: a Props and its copies must not be written concurrently.
 class Props {
+    struct Storage;
+
 public:
+    // A single property record
+    struct Entry {
+        PropKey key;
+        std::type_index type;
+        std::any value;
+    };
+
+    // Props with more entries than this spill to the heap
+    static constexpr size_t InlineCapacity = 6;
+
     // Set a property
     template<typename T>
-    void set(const std::string& key, const T& value) {
-        props_[key] = value;
-        types_.insert_or_assign(key, std::type_index(typeid(T)));
+    void set(PropKey key, const T& value) {
+        assign<T>(key, value);
+    }
+
+    template<typename T>
+    void set(std::string_view key, const T& value) {
+        assign<T>(PropKey::intern(key), value);
+    }
+
+    // Rvalue overloads move the value into the record
+    template<typename T, typename = std::enable_if_t<!std::is_reference_v<T>>>
+    void set(PropKey key, T&& value) {
+        assign<T>(key, std::move(value));
+    }
+
+    template<typename T, typename = std::enable_if_t<!std::is_reference_v<T>>>
+    void set(std::string_view key, T&& value) {
+        assign<T>(PropKey::intern(key), std::move(value));
+    }
+
+    // Set a built-in field; checked and routed at compile time
+    template<BuiltinProps::Field F>
+    void setBuiltin(BuiltinProps::Type<F> value) {
+        edit().builtins.set<F>(value);
+        eraseEntry(BuiltinProps::keyOf(F));
+    }
+
+    // Set every field present in fields
+    void setBuiltins(const BuiltinProps& fields) {
+        if (fields.empty()) {
+            return;
+        }
+        Storage& storage = edit();
+        for (uint8_t i = 0; i < BuiltinProps::FieldCount; ++i) {
+            auto field = static_cast<BuiltinProps::Field>(i);
+            if (fields.has(field)) {
+                storage.builtins.copyField(fields, field);
+                eraseEntry(BuiltinProps::keyOf(field));
+            }
+        }
     }
     
+    // Typed built-in fields, for reading without key lookups
+    const BuiltinProps& builtins() const { return data().builtins; }
+    
+    // The other entries: every prop not in builtins()
+    const SmallVector<Entry, InlineCapacity>& entries() const { return data().entries; }
+
+    // True if both hold the same storage block, i.e. one is an unmodified
+    // copy of the other. Implies equality; the converse does not hold.
+    bool sharesStorageWith(const Props& other) const { return storage_ == other.storage_; }
+
     // Get a property (throws on type mismatch)
     template<typename T>
-    T get(const std::string& key) const {
-        auto it = props_.find(key);
-        if (it == props_.end()) {
-            throw std::runtime_error("Property '" + key + "' not found");
+    T get(PropKey key) const {
+        if (auto field = builtinField(key)) {
+            if (const T* value = data().builtins.slot<T>(*field)) {
+                return *value;
+            }
+            throw std::runtime_error("Property '" + key.name() + "' type mismatch");
         }
-        
-        auto typeIt = types_.find(key);
-        if (typeIt == types_.end() || typeIt->second != std::type_index(typeid(T))) {
-            throw std::runtime_error("Property '" + key + "' type mismatch");
+        const Entry* entry = findEntry(key);
+        if (!entry) {
+            throw std::runtime_error("Property '" + key.name() + "' not found");
         }
-        
-        try {
-            return std::any_cast<T>(it->second);
-        } catch (const std::bad_any_cast& e) {
-            throw std::runtime_error("Property '" + key + "' type cast failed: " + e.what());
+        return getValue<T>(*entry);
+    }
+
+    template<typename T>
+    T get(std::string_view key) const {
+        PropKey resolved = PropKey::find(key);
+        if (!has(resolved)) {
+            throw std::runtime_error("Property '" + std::string(key) + "' not found");
         }
+        return get<T>(resolved);
     }
-    
+
     // Try to get a property (returns optional)
     template<typename T>
-    std::optional<T> tryGet(const std::string& key) const {
-        auto it = props_.find(key);
-        if (it == props_.end()) {
-            return std::nullopt;
+    std::optional<T> tryGet(PropKey key) const {
+        if (const T* value = getIf<T>(key)) {
+            return *value;
         }
-        
-        auto typeIt = types_.find(key);
-        if (typeIt == types_.end() || typeIt->second != std::type_index(typeid(T))) {
-            return std::nullopt;
+        return std::nullopt;
+    }
+
+    template<typename T>
+    std::optional<T> tryGet(std::string_view key) const {
+        return tryGet<T>(PropKey::find(key));
+    }
+
+    // Pointer to a property's value without copying or throwing: nullptr if
+    // the key is missing or holds another type. Valid until the property is
+    // set again or removed.
+    template<typename T>
+    const T* getIf(PropKey key) const {
+        if (auto field = builtinField(key)) {
+            return data().builtins.slot<T>(*field);
         }
-        
-        try {
-            return std::any_cast<T>(it->second);
-        } catch (const std::bad_any_cast&) {
-            return std::nullopt;
+        const Entry* entry = findEntry(key);
+        if (!entry || entry->type != std::type_index(typeid(T))) {
+            return nullptr;
         }
+        return std::any_cast<T>(&entry->value);
     }
-    
+
+    template<typename T>
+    const T* getIf(std::string_view key) const {
+        return getIf<T>(PropKey::find(key));
+    }
+
+    // Value of a property, or fallback if it is missing or holds another
+    // type. The result may refer to fallback, so copy it when passing a
+    // temporary.
+    template<typename T>
+    const T& getOr(PropKey key, const T& fallback) const {
+        const T* value = getIf<T>(key);
+        return value ? *value : fallback;
+    }
+
+    // Call visitor with a const reference to the value if it holds one of
+    // Ts (first match wins). Returns false if the key is missing or holds
+    // another type. Example:
+    //   props.visit<uint32_t, std::string>(keys::color, [&](const auto& c) { ... });
+    template<typename... Ts, typename Visitor>
+    bool visit(PropKey key, Visitor&& visitor) const {
+        static_assert(sizeof...(Ts) > 0, "visit needs at least one value type");
+        if (auto field = builtinField(key)) {
+            return (visitBuiltin<Ts>(*field, visitor) || ...);
+        }
+        const Entry* entry = findEntry(key);
+        if (!entry) {
+            return false;
+        }
+        return (visitAs<Ts>(*entry, visitor) || ...);
+    }
+
     // Check if property exists
-    bool has(const std::string& key) const {
-        return props_.find(key) != props_.end();
+    bool has(PropKey key) const {
+        return builtinField(key) || findEntry(key) != nullptr;
     }
-    
+
+    bool has(std::string_view key) const {
+        return has(PropKey::find(key));
+    }
+
     // Remove a property
-    void remove(const std::string& key) {
-        props_.erase(key);
-        types_.erase(key);
+    void remove(PropKey key) {
+        clearBuiltin(key);
+        eraseEntry(key);
     }
-    
+
+    void remove(std::string_view key) {
+        remove(PropKey::find(key));
+    }
+
     // Get type information
-    std::optional<std::type_index> getType(const std::string& key) const {
-        auto it = types_.find(key);
-        if (it != types_.end()) {
-            return it->second;
+    std::optional<std::type_index> getType(PropKey key) const {
+        if (auto field = builtinField(key)) {
+            return BuiltinProps::isColor(*field) ? std::type_index(typeid(uint32_t)) : std::type_index(typeid(int));
+        }
+        if (const Entry* entry = findEntry(key)) {
+            return entry->type;
         }
         return std::nullopt;
     }
-    
-    // Merge another Props object
+
+    std::optional<std::type_index> getType(std::string_view key) const {
+        return getType(PropKey::find(key));
+    }
+
+    // Merge another Props object (values from other win)
     void merge(const Props& other) {
-        for (const auto& [key, value] : other.props_) {
-            props_[key] = value;
-            types_.insert({key, other.types_.at(key)});
+        if (other.empty() || sharesStorageWith(other)) {
+            return;
+        }
+        if (empty()) {
+            storage_ = other.storage_;
+            return;
+        }
+        const Storage& source = other.data();
+        for (uint8_t i = 0; i < BuiltinProps::FieldCount; ++i) {
+            auto field = static_cast<BuiltinProps::Field>(i);
+            if (source.builtins.has(field)) {
+                edit().builtins.copyField(source.builtins, field);
+                eraseEntry(BuiltinProps::keyOf(field));
+            }
+        }
+        for (const auto& otherEntry : source.entries) {
+            upsertEntry(otherEntry);
         }
     }
-    
-    // Equality comparison (shallow)
+
+    // Copy a single property of any type from other (no-op if other lacks it)
+    void copyFrom(const Props& other, PropKey key) {
+        if (auto field = other.builtinField(key)) {
+            edit().builtins.copyField(other.data().builtins, *field);
+            eraseEntry(key);
+        } else if (const Entry* otherEntry = other.findEntry(key)) {
+            upsertEntry(*otherEntry);
+        }
+    }
+
+    // Equality comparison (shallow): same keys, types and values.
+    // Values are compared through PropComparators.
     bool operator==(const Props& other) const {
-        if (props_.size() != other.props_.size()) {
+        if (sharesStorageWith(other)) {
+            return true;
+        }
+        const Storage& lhs = data();
+        const Storage& rhs = other.data();
+        if (lhs.builtins != rhs.builtins || lhs.entries.size() != rhs.entries.size()) {
             return false;
         }
-        
-        for (const auto& [key, value] : props_) {
-            auto otherIt = other.props_.find(key);
-            if (otherIt == other.props_.end()) {
+
+        for (const auto& entry : lhs.entries) {
+            const Entry* otherEntry = other.findEntry(entry.key);
+            if (!otherEntry || otherEntry->type != entry.type) {
                 return false;
             }
-            
-            // Compare types
-            auto thisTypeIt = types_.find(key);
-            auto otherTypeIt = other.types_.find(key);
-            if (thisTypeIt == types_.end() || otherTypeIt == other.types_.end() ||
-                thisTypeIt->second != otherTypeIt->second) {
+            if (!PropComparators::equal(entry.type, entry.value, otherEntry->value)) {
                 return false;
             }
-            
-            // For std::function, we can't compare directly, so we compare addresses
-            // For other types, we'd need type-specific comparison
-            // This is a simplified shallow comparison
         }
-        
+
         return true;
     }
-    
+
     bool operator!=(const Props& other) const {
         return !(*this == other);
     }
+
+    // Order-independent hash of keys, types and values.
+    // Values are hashed through PropComparators; types without a registered
+    // hash contribute only their type.
+    uint64_t hash() const;
     
-    // Iterator support
-    using iterator = std::unordered_map<std::string, std::any>::iterator;
-    using const_iterator = std::unordered_map<std::string, std::any>::const_iterator;
-    
-    iterator begin() { return props_.begin(); }
-    iterator end() { return props_.end(); }
-    const_iterator begin() const { return props_.begin(); }
-    const_iterator end() const { return props_.end(); }
-    const_iterator cbegin() const { return props_.cbegin(); }
-    const_iterator cend() const { return props_.cend(); }
+    // False if some value has a type without a registered hash, so equal
+    // hashes don't imply equal props
+    bool isFullyHashed() const;
     
+    // Equality and hash that ignore event handlers (PropComparators::isHandler).
+    // Props differing only in their handlers paint the same, so caches of
+    // visual state key on these.
+    bool visuallyEquals(const Props& other) const;
+    uint64_t visualHash() const;
+
+    // Read-only iteration over every prop: the set builtins() fields (as
+    // int or uint32_t entries) in key order, then entries(). Elements are
+    // Entry records (key, type, value), not pair<const string, any>: write
+    // `for (const auto& entry : props)`. A builtin's Entry lives in the
+    // iterator, so a reference is valid until the iterator moves on.
+    class const_iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry*;
+        using reference = const Entry&;
+
+        reference operator*() const {
+            return field_ < BuiltinProps::FieldCount ? *builtin_ : storage_->entries[index_];
+        }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            if (field_ < BuiltinProps::FieldCount) {
+                ++field_;
+                settle();
+            } else {
+                ++index_;
+            }
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const {
+            return field_ == other.field_ && index_ == other.index_;
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class Props;
+
+        const_iterator(const Storage& storage, uint8_t field, size_t index)
+            : storage_(&storage), field_(field), index_(index) {
+            settle();
+        }
+
+        // Move to the next set field at or after field_, materializing it
+        void settle() {
+            const BuiltinProps& fields = storage_->builtins;
+            while (field_ < BuiltinProps::FieldCount && !fields.has(static_cast<BuiltinProps::Field>(field_))) {
+                ++field_;
+            }
+            if (field_ == BuiltinProps::FieldCount) {
+                builtin_.reset();
+                return;
+            }
+            auto field = static_cast<BuiltinProps::Field>(field_);
+            if (BuiltinProps::isColor(field)) {
+                builtin_.emplace(Entry{BuiltinProps::keyOf(field), typeid(uint32_t), *fields.slot<uint32_t>(field)});
+            } else {
+                builtin_.emplace(Entry{BuiltinProps::keyOf(field), typeid(int), *fields.slot<int>(field)});
+            }
+        }
+
+        const Storage* storage_;
+        uint8_t field_;
+        size_t index_;
+        std::optional<Entry> builtin_;
+    };
+    using iterator = const_iterator;
+
+    const_iterator begin() const { return const_iterator(data(), 0, 0); }
+    const_iterator end() const { return const_iterator(data(), BuiltinProps::FieldCount, data().entries.size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
     // Size
-    size_t size() const { return props_.size(); }
-    bool empty() const { return props_.empty(); }
-    
+    size_t size() const { return data().entries.size() + data().builtins.size(); }
+    bool empty() const { return !storage_ || (data().entries.empty() && data().builtins.empty()); }
+
     // Clear
     void clear() {
-        props_.clear();
-        types_.clear();
+        storage_.reset();
     }
-    
+
 private:
-    std::unordered_map<std::string, std::any> props_;
-    std::unordered_map<std::string, std::type_index> types_;
+    struct Storage {
+        BuiltinProps builtins;
+        SmallVector<Entry, InlineCapacity> entries;
+    };
+
+    static const Storage& emptyStorage() {
+        static const Storage empty;
+        return empty;
+    }
+
+    const Storage& data() const {
+        return storage_ ? *storage_ : emptyStorage();
+    }
+    
+    uint64_t hashImpl(bool skipHandlers) const;
+
+    // Resource for new storage blocks: as for VNode::allocate
+    static std::pmr::memory_resource* resource();
+
+    // Storage that is safe to write: allocated on first use, cloned if shared
+    Storage& edit() {
+        if (!storage_) {
+            storage_ = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(resource()));
+        } else if (storage_.use_count() > 1) {
+            storage_ = std::allocate_shared<Storage>(std::pmr::polymorphic_allocator<Storage>(resource()), *storage_);
+        }
+        return *storage_;
+    }
+
+    // Only called after edit()
+    Entry* editEntry(PropKey key) {
+        for (auto& entry : storage_->entries) {
+            if (entry.key == key) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    const Entry* findEntry(PropKey key) const {
+        for (const auto& entry : data().entries) {
+            if (entry.key == key) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    // Built-in field holding key, if it is set
+    std::optional<BuiltinProps::Field> builtinField(PropKey key) const {
+        auto field = BuiltinProps::fieldOf(key);
+        if (field && data().builtins.has(*field)) {
+            return field;
+        }
+        return std::nullopt;
+    }
+
+    // The erase helpers only unshare the storage if they have work to do
+    void clearBuiltin(PropKey key) {
+        if (auto field = builtinField(key)) {
+            edit().builtins.clear(*field);
+        }
+    }
+
+    void eraseEntry(PropKey key) {
+        if (!findEntry(key)) {
+            return;
+        }
+        auto& entries = edit().entries;
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->key == key) {
+                entries.erase(it);
+                return;
+            }
+        }
+    }
+
+    // Store a generic entry, replacing the key wherever it was held
+    void upsertEntry(const Entry& source) {
+        clearBuiltin(source.key);
+        Storage& storage = edit();
+        if (Entry* entry = editEntry(source.key)) {
+            entry->type = source.type;
+            entry->value = source.value;
+        } else {
+            storage.entries.push_back(source);
+        }
+    }
+
+    template<typename T, typename Arg>
+    void assign(PropKey key, Arg&& value) {
+        if constexpr (std::is_same_v<T, int> || std::is_same_v<T, uint32_t>) {
+            if (auto field = BuiltinProps::fieldOf(key)) {
+                if (edit().builtins.assign<T>(*field, value)) {
+                    eraseEntry(key);
+                    return;
+                }
+            }
+        }
+        clearBuiltin(key);
+        Storage& storage = edit();
+        if (Entry* entry = editEntry(key)) {
+            entry->type = std::type_index(typeid(T));
+            entry->value = std::forward<Arg>(value);
+            return;
+        }
+        storage.entries.emplace_back(Entry{key, std::type_index(typeid(T)), std::any(std::forward<Arg>(value))});
+    }
+
+    template<typename T, typename Visitor>
+    bool visitBuiltin(BuiltinProps::Field field, Visitor& visitor) const {
+        if (const T* value = data().builtins.slot<T>(field)) {
+            visitor(*value);
+            return true;
+        }
+        return false;
+    }
+
+    template<typename T, typename Visitor>
+    static bool visitAs(const Entry& entry, Visitor& visitor) {
+        if (entry.type != std::type_index(typeid(T))) {
+            return false;
+        }
+        visitor(*std::any_cast<T>(&entry.value));
+        return true;
+    }
+
+    template<typename T>
+    static T getValue(const Entry& entry) {
+        // Key names are only resolved on the error path
+        if (entry.type != std::type_index(typeid(T))) {
+            throw std::runtime_error("Property '" + entry.key.name() + "' type mismatch");
+        }
+
+        const T* value = std::any_cast<T>(&entry.value);
+        if (!value) {
+            throw std::runtime_error("Property '" + entry.key.name() + "' type cast failed");
+        }
+        return *value;
+    }
+
+    std::shared_ptr<Storage> storage_;  // Null while empty
 };
 
 } // namespace reactpp
-
@@ -2,20 +2,134 @@
 
 #include "VNode.hpp"
 #include "FiberNode.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 namespace reactpp {
 
+// Diffs two VNode trees into a fiber tree for the new one.
+//
+// Children are matched by key (explicit, else implicit; see ImplicitKeys)
+// and, when unkeyed, by type at the same position among unkeyed siblings.
+// Matched children whose old positions form the longest increasing
+// subsequence stay where they are; the other matched children are moved
+// and tagged Placement, as are new children. Unmatched old children get
+// Deletion fibers. A matched node whose own props or text changed is
+// tagged Update. Matched subtrees that are the same node or unchanged (by
+// VNode::isSameSubtree: the structural hash, plus the props it can't
+// hash) are not descended into; their fibers share the current fibers'
+// children.
+//
+// A component node's child is its render() output. A matched component
+// with the same instance, props equal by Component::propsEqual and a clean
+// hook manager is not rendered again: like an unchanged subtree, its fiber
+// shares the current fiber's children, unless a component below has a
+// dirty hook manager. Rendering leaves the instance untouched: its new
+// props and its consumed dirty flag are applied by commit(), so a render
+// that is dropped part-way changes nothing. Unchanged subtrees that contain components are not
+// skipped but walked, so every component in them is checked this way.
+//
+// Fiber trees are double-buffered. Given the current (committed) fiber
+// tree, each matched node's work-in-progress fiber is the current fiber's
+// alternate from the render before, reset and reused, so re-rendering a
+// tree of unchanged shape allocates no fibers once both buffers exist.
+// Given a VNode instead, the previous tree has no fibers to recycle.
+// Children shared by a skip belong to both trees; commit() points their
+// return_ at the parent in the tree being committed.
 class Reconciler {
 public:
+    struct Stats {
+        size_t fibers = 0;      // Fibers in the new tree, reused or not
+        size_t reused = 0;      // Fibers recycled from alternates
+        size_t skipped = 0;     // Matched subtrees not descended into
+        size_t placements = 0;  // New or moved nodes
+        size_t moves = 0;       // Placements of matched nodes
+        size_t updates = 0;
+        size_t deletions = 0;
+        size_t renders = 0;     // Components whose render() was called
+        size_t bailouts = 0;    // Matched components not rendered again
+    };
+
     Reconciler();
     ~Reconciler();
-    
-    // Reconciliation methods - to be implemented
+
+    // Fiber tree for next, with current as the previous render (null on the
+    // first). The root's effectList holds every fiber below it with an
+    // effect, grouped by parent (deletions first) with parents before their
+    // descendants; the root's own tag is only on the root. With no next
+    // node, returns a Deletion fiber for current (or null). Commits when
+    // done (see commit()).
+    FiberNode::Ptr reconcile(const FiberNode::Ptr& current, VNode::Ptr next);
     FiberNode::Ptr reconcile(VNode::Ptr current, VNode::Ptr next);
+    FiberNode::Ptr reconcile(std::nullptr_t, VNode::Ptr next) {
+        return reconcile(FiberNode::Ptr(), std::move(next));
+    }
+
+    // Resumable form of reconcile(): begin() returns the root fiber (final
+    // for a deletion), then each performUnitOfWork() call creates one
+    // fiber's children, walking child, sibling and return_ links. Returns
+    // false once the tree is done; until then the tree is incomplete. Call
+    // commit() when the finished tree is committed; begin() drops the
+    // previous render's uncommitted work.
+    FiberNode::Ptr begin(const FiberNode::Ptr& current, VNode::Ptr next);
+    FiberNode::Ptr begin(VNode::Ptr current, VNode::Ptr next);
+    FiberNode::Ptr begin(std::nullptr_t, VNode::Ptr next) {
+        return begin(FiberNode::Ptr(), std::move(next));
+    }
+    bool performUnitOfWork();
+    bool hasWork() const { return next_ != nullptr; }
     
+    // Apply the last render's updates to the components it rendered (their
+    // new props, and clearing the dirty flags the render consumed), and
+    // re-parent the children it shared with the current tree
+    void commit();
+
+    // Counts for the last reconcile() (or begin())
+    const Stats& stats() const { return stats_; }
+
 private:
-    // Implementation details
+    // Create the fiber's child fibers, diffing against its alternate.
+    // Returns false if its children are shared with the current tree and
+    // must not be walked.
+    bool beginWork(FiberNode& fiber, FiberNode& root);
+    // Render the component, or reuse the current children if it is clean
+    bool updateComponent(FiberNode& fiber, FiberNode* current, FiberNode& root);
+    // Child fibers for children, diffed against current's (mounted when
+    // there is no current)
+    void reconcileChildren(FiberNode& fiber, FiberNode* current,
+                           const VNode::Ptr* children, size_t count, FiberNode& root);
+    // Share current's children instead of walking them
+    void bailout(FiberNode& fiber, FiberNode& current);
+
+    // Fiber for a new node
+    FiberNode::Ptr createFiber(const VNode::Ptr& node, FiberNode* parent);
+    // Fiber for node replacing current: current's alternate if it has one
+    FiberNode::Ptr workInProgress(FiberNode& current, const VNode::Ptr& node, FiberNode* parent);
+
+    // A component rendered by the current render, for commit()
+    struct RenderedComponent {
+        std::shared_ptr<Component> component;
+        Props props;
+        uint64_t marks;  // HookManager::markCount() when it rendered
+    };
+
+    FiberNode::Ptr root_;          // Tree being built
+    FiberNode* next_ = nullptr;    // Next unit of work
+    Stats stats_;
+    std::vector<RenderedComponent> rendered_;
+    std::vector<FiberNode::Ptr> shared_;  // Fibers given current's children, for commit()
+
+    // Scratch space for reconcileChildren, kept to avoid allocating per call
+    std::vector<FiberNode::Ptr> oldFibers_;
+    std::vector<std::pair<uint64_t, uint32_t>> oldSlots_;  // Slot, old position
+    std::vector<char> matched_;
+    std::vector<int32_t> sources_;
+    std::vector<FiberNode*> newFibers_;
+    std::vector<size_t> tails_;
+    std::vector<size_t> previous_;
+    std::vector<char> stay_;
 };
 
 } // namespace reactpp
-
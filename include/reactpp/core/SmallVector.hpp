@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
+#include <algorithm>
+
+namespace reactpp {
+
+// Vector with inline storage for the first N elements.
+// Only spills to the heap once more than N elements are stored, which keeps
+// small collections (props, traversal stacks) contiguous with their owner.
+template<typename T, size_t N>
+class SmallVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() : data_(inlineData()), size_(0), capacity_(N) {}
+
+    SmallVector(std::initializer_list<T> init) : SmallVector() {
+        reserve(init.size());
+        for (const auto& value : init) {
+            push_back(value);
+        }
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other.size_);
+        for (const auto& value : other) {
+            push_back(value);
+        }
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallVector() {
+        moveFrom(std::move(other));
+    }
+
+    ~SmallVector() {
+        clear();
+        releaseHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (const auto& value : other) {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            moveFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    // Element access
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    // Iterators
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    // Capacity
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    bool isInline() const { return data_ == inlineData(); }
+    static constexpr size_t inlineCapacity() { return N; }
+
+    void reserve(size_t newCapacity) {
+        if (newCapacity > capacity_) {
+            grow(newCapacity);
+        }
+    }
+
+    // Modifiers
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            grow(capacity_ * 2);
+        }
+        T* slot = new (data_ + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void pop_back() {
+        --size_;
+        data_[size_].~T();
+    }
+
+    iterator erase(iterator pos) {
+        std::move(pos + 1, end(), pos);
+        pop_back();
+        return pos;
+    }
+
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            data_[i].~T();
+        }
+        size_ = 0;
+    }
+
+private:
+    T* inlineData() { return reinterpret_cast<T*>(inline_); }
+    const T* inlineData() const { return reinterpret_cast<const T*>(inline_); }
+
+    void grow(size_t newCapacity) {
+        T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        for (size_t i = 0; i < size_; ++i) {
+            new (newData + i) T(std::move(data_[i]));
+            data_[i].~T();
+        }
+        releaseHeap();
+        data_ = newData;
+        capacity_ = newCapacity;
+    }
+
+    void releaseHeap() {
+        if (!isInline()) {
+            ::operator delete(data_);
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Expects *this to be empty and inline
+    void moveFrom(SmallVector&& other) {
+        if (other.isInline()) {
+            for (size_t i = 0; i < other.size_; ++i) {
+                new (data_ + i) T(std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.size_ = 0;
+            other.capacity_ = N;
+        }
+    }
+
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+};
+
+} // namespace reactpp
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "InternTable.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace reactpp {
+
+// Interned element tag. Renderers dispatch on the id instead of comparing
+// tag strings; the name is only needed for debugging and serialization.
+class TagId {
+public:
+    constexpr TagId() : id_(InternTable::InvalidId) {}
+    constexpr explicit TagId(uint32_t id) : id_(id) {}
+    explicit TagId(std::string_view name) : id_(intern(name).id_) {}
+    
+    // Resolve a tag name, adding it to the tag table if needed.
+    // The empty name maps to the invalid tag (text and fragment nodes).
+    static TagId intern(std::string_view name);
+    
+    // Resolve a tag name without adding it (invalid tag if never interned)
+    static TagId find(std::string_view name);
+    
+    constexpr uint32_t id() const { return id_; }
+    constexpr bool valid() const { return id_ != InternTable::InvalidId; }
+    const std::string& name() const { return table().name(id_); }
+    
+    constexpr bool operator==(TagId other) const { return id_ == other.id_; }
+    constexpr bool operator!=(TagId other) const { return id_ != other.id_; }
+    constexpr bool operator<(TagId other) const { return id_ < other.id_; }
+    
+private:
+    static InternTable& table();
+    
+    uint32_t id_;
+};
+
+// Built-in element tags. Ids are fixed: TagId::table() pre-interns these
+// names in this order. The raw ids are usable as switch labels.
+namespace tags {
+    enum : uint32_t {
+        ViewId = 1,
+        ButtonId,
+        TextId,
+        InputId
+    };
+    
+    constexpr TagId View{ViewId};
+    constexpr TagId Button{ButtonId};
+    constexpr TagId Text{TextId};
+    constexpr TagId Input{InputId};
+} // namespace tags
+
+} // namespace reactpp
+
+namespace std {
+template<>
+struct hash<reactpp::TagId> {
+    size_t operator()(reactpp::TagId tag) const noexcept {
+        return std::hash<uint32_t>{}(tag.id());
+    }
+};
+} // namespace std
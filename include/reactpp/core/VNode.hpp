@@ -1,12 +1,19 @@
 #pragma once
 
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <optional>
 #include <atomic>
 #include <functional>
+#include <type_traits>
+#include <utility>
 #include "Props.hpp"
+#include "TagId.hpp"
+#include "SmallVector.hpp"
 
 namespace reactpp {
 
@@ -17,45 +24,111 @@ enum class VNodeType {
     Fragment
 };
 
+// Returned by traversal visitors to steer the walk
+enum class VisitResult {
+    Continue,      // Visit this node's children
+    SkipChildren,  // Don't descend into this node
+    Stop           // End the traversal
+};
+
 class Component;
 
+// Render-to-render node identity (see VNode::getStableId). Not the same
+// thing as VNode::getId(), which is new for every node.
+using StableId = uint64_t;
+
 class VNode : public std::enable_shared_from_this<VNode> {
 public:
     using Ptr = std::shared_ptr<VNode>;
     using WeakPtr = std::weak_ptr<VNode>;
+    using Children = std::pmr::vector<Ptr>;
+    
+    // Selects the variadic factories: one or more arguments convertible to Ptr
+    template<typename... Args>
+    using EnableIfChildren = std::enable_if_t<
+        (sizeof...(Args) > 0) && (std::is_convertible_v<Args, Ptr> && ...)>;
     
-    // Factory methods
+    // Factory methods. Arguments are taken by value: pass temporaries (or
+    // std::move) to hand them over without copying.
     static Ptr createElement(
-        const std::string& tag,
-        const Props& props = Props(),
-        const std::vector<Ptr>& children = {}
+        TagId tag,
+        Props props = Props(),
+        std::vector<Ptr> children = {}
     );
     
-    static Ptr createText(const std::string& text);
+    static Ptr createElement(
+        std::string_view tag,
+        Props props = Props(),
+        std::vector<Ptr> children = {}
+    ) {
+        return createElement(TagId::intern(tag), std::move(props), std::move(children));
+    }
+    
+    // Text nodes carry their own props (style, position, onClick) rather
+    // than relying on a wrapper element
+    static Ptr createText(std::string text, Props props = Props());
     
     static Ptr createComponent(
         std::shared_ptr<Component> component,
-        const Props& props = Props(),
-        const std::vector<Ptr>& children = {}
+        Props props = Props(),
+        std::vector<Ptr> children = {}
     );
     
-    static Ptr createFragment(const std::vector<Ptr>& children = {});
+    static Ptr createFragment(std::vector<Ptr> children = {});
+    
+    // Variadic children are emplaced straight into the node, skipping the
+    // temporary vector
+    template<typename... Children, typename = EnableIfChildren<Children...>>
+    static Ptr createElement(TagId tag, Props props, Children&&... children) {
+        auto node = allocate(VNodeType::Element);
+        node->tag_ = tag;
+        node->props_ = std::move(props);
+        node->emplaceChildren(std::forward<Children>(children)...);
+        return node;
+    }
+    
+    template<typename... Children, typename = EnableIfChildren<Children...>>
+    static Ptr createElement(std::string_view tag, Props props, Children&&... children) {
+        return createElement(TagId::intern(tag), std::move(props), std::forward<Children>(children)...);
+    }
+    
+    template<typename... Children, typename = EnableIfChildren<Children...>>
+    static Ptr createComponent(std::shared_ptr<Component> component, Props props, Children&&... children) {
+        auto node = allocate(VNodeType::Component);
+        node->component_ = std::move(component);
+        node->props_ = std::move(props);
+        node->emplaceChildren(std::forward<Children>(children)...);
+        return node;
+    }
+    
+    template<typename... Children, typename = EnableIfChildren<Children...>>
+    static Ptr createFragment(Children&&... children) {
+        auto node = allocate(VNodeType::Fragment);
+        node->emplaceChildren(std::forward<Children>(children)...);
+        return node;
+    }
     
     // Getters
     VNodeType getType() const { return type_; }
-    const std::string& getTag() const { return tag_; }
+    const std::string& getTag() const { return tag_.name(); }  // Empty for non-elements
+    TagId getTagId() const { return tag_; }
     const std::string& getText() const { return text_; }
     const Props& getProps() const { return props_; }
-    Props& getProps() { return props_; }
-    const std::vector<Ptr>& getChildren() const { return children_; }
-    std::vector<Ptr>& getChildren() { return children_; }
+    Props& getProps() { ensureMutable(); invalidateHash(); return props_; }  // May be modified: drops cached hash
+    const Children& getChildren() const { return children_; }
+    Children& getChildren() { ensureMutable(); invalidateHash(); return children_; }  // May be modified: drops cached hash (bypasses the index)
     const std::optional<std::string>& getKey() const { return key_; }
-    uint64_t getId() const { return id_; }
+    // Key derived from the factory call site (see ImplicitKeys) and the
+    // node's position among siblings from the same site; 0 if none
+    uint64_t getImplicitKey() const;
+    uint64_t getId() const { return id_; }  // Unique per node: a new value every render
     WeakPtr getParent() const { return parent_; }
     std::shared_ptr<Component> getComponent() const { return component_; }
     
     // Setters
-    void setKey(const std::optional<std::string>& key) { key_ = key; }
+    void setKey(const std::optional<std::string>& key);
+    // Set by the element factories before the node is attached to a parent
+    void setImplicitKey(uint64_t siteKey);
     void setParent(WeakPtr parent) { parent_ = parent; }
     
     // Tree manipulation
@@ -64,42 +137,315 @@ public:
     void replaceChild(Ptr oldChild, Ptr newChild);
     void insertBefore(Ptr newChild, Ptr sibling);
     
+    // Append detached subtrees (e.g. built on worker threads) in one step.
+    // Only the subtree roots are touched, so each splice is O(1) regardless
+    // of subtree size (unless this tree is indexed).
+    void appendChildren(std::vector<Ptr> children);
+    
     // Tree traversal
     void traversePreOrder(std::function<void(Ptr)> visitor);
     void traversePostOrder(std::function<void(Ptr)> visitor);
     void traverseLevelOrder(std::function<void(Ptr)> visitor);
     
+    // Iterative traversals with an explicit stack; no recursion, no shared_ptr
+    // copies. Visitors take VNode& (or const VNode&) and return void or a
+    // VisitResult. Return false if a visitor stopped the walk.
+    template<typename Visitor>
+    bool visitPreOrder(Visitor&& visitor) {
+        return visitDepthFirst(this, visitor, noopVisitor);
+    }
+    
+    template<typename Visitor>
+    bool visitPreOrder(Visitor&& visitor) const {
+        return visitDepthFirst(this, visitor, noopVisitor);
+    }
+    
+    template<typename Visitor>
+    bool visitPostOrder(Visitor&& visitor) {
+        return visitDepthFirst(this, noopVisitor, visitor);
+    }
+    
+    template<typename Visitor>
+    bool visitPostOrder(Visitor&& visitor) const {
+        return visitDepthFirst(this, noopVisitor, visitor);
+    }
+    
+    // Calls enter on the way down and leave on the way up. SkipChildren from
+    // enter goes straight to leave for that node.
+    template<typename Enter, typename Leave>
+    bool visitDepthFirst(Enter&& enter, Leave&& leave) {
+        return visitDepthFirst(this, enter, leave);
+    }
+    
+    template<typename Enter, typename Leave>
+    bool visitDepthFirst(Enter&& enter, Leave&& leave) const {
+        return visitDepthFirst(this, enter, leave);
+    }
+    
+    template<typename Visitor>
+    bool visitLevelOrder(Visitor&& visitor) {
+        return visitLevelOrder(this, visitor);
+    }
+    
+    template<typename Visitor>
+    bool visitLevelOrder(Visitor&& visitor) const {
+        return visitLevelOrder(this, visitor);
+    }
+    
     // Finding
-    Ptr findChildByKey(const std::string& key) const;
-    Ptr findById(uint64_t id) const;
+    Ptr findChildByKey(const std::string& key) const;       // Direct children only
+    Ptr findDescendantByKey(const std::string& key) const;  // Whole subtree, pre-order
+    Ptr findById(uint64_t id) const;                        // This node or a descendant
+    
+    // Lookup index for this tree: id -> node and (parent, key) -> child.
+    // Kept up to date by appendChild/removeChild/replaceChild/insertBefore and
+    // setKey; children edited directly through getChildren() are not tracked.
+    // Subtrees attached to an indexed node join its index, detached subtrees
+    // leave it. With an index findById and findChildByKey are O(1) (plus an
+    // ancestry check when called below the indexed root).
+    void enableIndex();
+    void disableIndex();
+    bool isIndexed() const { return index_ != nullptr; }
     
-    // Cloning
+    // Cloning. cloneDeep shares frozen subtrees instead of copying them, so
+    // cloning a frozen tree is O(1).
     Ptr cloneShallow() const;
     Ptr cloneDeep() const;
     
+    // Immutable mode. freeze() makes this subtree read-only: the tree
+    // operations, setKey and the non-const getters throw on frozen nodes,
+    // so frozen subtrees can be shared between trees. Read frozen nodes
+    // through const references.
+    void freeze();
+    bool isFrozen() const { return frozen_; }
+    
+    // Static subtrees. hoist() freezes the subtree under node and marks its
+    // root as hoisted: built once, kept by its owner (see Component::hoisted)
+    // and placed into every render. A hoisted subtree found again at the same
+    // place is recognized by identity, and the per-render passes (stable ids,
+    // style resolution, render tree updates) skip it. Place a hoisted subtree
+    // at most once per tree.
+    static Ptr hoist(Ptr node);
+    bool isHoisted() const { return hoisted_; }
+    
+    // True if nothing in the subtree can change from one render to the next
+    // on its own: no component nodes and no event handler props. Says
+    // nothing about the data the subtree was built from.
+    bool isStatic() const;
+    
+    // Unfrozen copy of this node that shares its children
+    Ptr cloneForEdit() const;
+    
+    // Persistent updates of a frozen node: each returns a new frozen node
+    // that shares every child it didn't touch
+    Ptr withProps(Props props) const;
+    Ptr withKey(const std::optional<std::string>& key) const;
+    Ptr withChildAppended(Ptr child) const;
+    Ptr withChildInserted(Ptr newChild, const Ptr& sibling) const;
+    Ptr withChildRemoved(const Ptr& child) const;
+    Ptr withChildReplaced(const Ptr& oldChild, Ptr newChild) const;
+    
+    // Path copying: returns a new frozen root in which target (a node of the
+    // frozen tree under root) is replaced by an edited copy. Only the nodes
+    // on the path from root to target are copied. Parent links of shared
+    // nodes follow the most recently built tree.
+    static Ptr updateIn(const Ptr& root, const VNode& target, const std::function<void(VNode&)>& edit);
+    
+    // Render-to-render identity. Derived from the parent's stable id, the
+    // key (or, for unkeyed nodes, the implicit key if implicit keys are on,
+    // else the position among non-null siblings),
+    // the type and tag, and the component instance, so the node at the same
+    // place in the next render gets the same value. Use it, not getId(), to
+    // key per-node caches that should survive re-renders.
+    //
+    // Cached by assignStableIds(), which renderers call once per render;
+    // until then it is derived from the current position by walking up the
+    // parent links. Not updated by later tree edits. Siblings sharing a key
+    // are told apart by how many earlier siblings use it (see
+    // ChildStableIds), so the first of them keeps the plain keyed id.
+    StableId getStableId() const;
+    
+    // Compute and cache stable ids for this subtree in one pass
+    void assignStableIds() const;
+    
+    // Stable id of a node given its parent's stable id, its position among
+    // the parent's non-null children and, for a keyed node, the number of
+    // earlier siblings with the same key. Root nodes pass 0 and 0. Walks
+    // over a parent's children should use ChildStableIds instead.
+    static StableId deriveStableId(StableId parentStableId, const VNode& node, size_t index,
+                                   size_t keyOccurrence = 0);
+    
     // Serialization
     std::string serialize() const;
     
-    // Equality
+    // Structural hash of the subtree: type, tag, key, text, props and children.
+    // Computed lazily and cached until the subtree is modified through the
+    // VNode API. Not safe to compute concurrently on a shared subtree.
+    uint64_t structuralHash() const;
+    
+    // Drop the cached hash of this node and its ancestors
+    void invalidateHash();
+    
+    // Unchanged check for diffing: true if both subtrees have the same
+    // structural hash. O(1) once hashed, except that props values the hash
+    // cannot see (types without a registered hash, such as std::function
+    // handlers) are compared directly, on the nodes that have them.
+    bool isSameSubtree(const VNode& other) const;
+    
+    // Equality (hash mismatch short-circuits; equal hashes are confirmed
+    // field by field). Iterative, so deep trees don't overflow the stack.
     bool operator==(const VNode& other) const;
     bool operator!=(const VNode& other) const;
     
     // Constructor (public to allow std::make_shared, but factory methods are preferred)
-    VNode(VNodeType type);
+    // Children arrays are allocated from the given resource
+    VNode(VNodeType type, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~VNode();
     
 private:
+    // Traversal stacks up to this depth (or queue width) stay on the stack
+    static constexpr size_t InlineTraversalDepth = 32;
+    
+    static constexpr auto noopVisitor = [](const VNode&) {};
+    
+    template<typename Visitor, typename Node>
+    static VisitResult invokeVisitor(Visitor& visitor, Node& node) {
+        if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, Node&>>) {
+            visitor(node);
+            return VisitResult::Continue;
+        } else {
+            return visitor(node);
+        }
+    }
+    
+    template<typename Node, typename Enter, typename Leave>
+    static bool visitDepthFirst(Node* root, Enter& enter, Leave& leave) {
+        struct Frame {
+            Node* node;
+            size_t next;
+        };
+        
+        VisitResult result = invokeVisitor(enter, *root);
+        if (result == VisitResult::Stop) return false;
+        if (result == VisitResult::SkipChildren) {
+            return invokeVisitor(leave, *root) != VisitResult::Stop;
+        }
+        
+        SmallVector<Frame, InlineTraversalDepth> stack;
+        stack.push_back({root, 0});
+        
+        while (!stack.empty()) {
+            Frame& top = stack.back();
+            if (top.next < top.node->children_.size()) {
+                Node* child = top.node->children_[top.next++].get();
+                if (!child) continue;
+                
+                result = invokeVisitor(enter, *child);
+                if (result == VisitResult::Stop) return false;
+                if (result == VisitResult::SkipChildren) {
+                    if (invokeVisitor(leave, *child) == VisitResult::Stop) return false;
+                    continue;
+                }
+                stack.push_back({child, 0});
+            } else {
+                Node* node = top.node;
+                stack.pop_back();
+                if (invokeVisitor(leave, *node) == VisitResult::Stop) return false;
+            }
+        }
+        return true;
+    }
+    
+    template<typename Node, typename Visitor>
+    static bool visitLevelOrder(Node* root, Visitor& visitor) {
+        SmallVector<Node*, InlineTraversalDepth> queue;
+        queue.push_back(root);
+        
+        for (size_t head = 0; head < queue.size(); ++head) {
+            Node* node = queue[head];
+            VisitResult result = invokeVisitor(visitor, *node);
+            if (result == VisitResult::Stop) return false;
+            if (result == VisitResult::SkipChildren) continue;
+            
+            for (const auto& child : node->children_) {
+                if (child) queue.push_back(child.get());
+            }
+        }
+        return true;
+    }
+    
+    uint64_t computeHash() const;
+    
+    // Throws if this node is frozen
+    void ensureMutable() const;
+    
+    template<typename... Args>
+    void emplaceChildren(Args&&... children) {
+        children_.reserve(sizeof...(Args));
+        (children_.emplace_back(std::forward<Args>(children)), ...);
+        adoptChildren();
+    }
+    
+    // Point every child's parent link at this node
+    void adoptChildren();
+    
+    // Number children that share an implicit site key in order (their loop
+    // index). Frozen children keep the number they were given when built.
+    void numberImplicitKeys();
+    
+    struct Index;
+    
+    // Add or remove this subtree from an index
+    void attachIndex(const std::shared_ptr<Index>& index);
+    void detachIndex();
+    bool isDescendantOf(const VNode* ancestor) const;
+    
+    // Allocates a node from the thread's NodeBlock or FrameArena if one is
+    // bound, else the heap
+    static Ptr allocate(VNodeType type);
+    
+    // Ids are handed out in per-thread blocks so parallel builds don't
+    // contend on the shared counter. Unique, but only ordered per thread.
+    static constexpr uint64_t IdBlockSize = 1024;
+    static uint64_t nextId();
     
     static std::atomic<uint64_t> next_id_;
     
     VNodeType type_;
     uint64_t id_;
-    std::string tag_;
+    TagId tag_;
     std::string text_;
     Props props_;
-    std::vector<Ptr> children_;
+    Children children_;
     std::optional<std::string> key_;
+    uint64_t implicitKey_;        // Site key; 0 if none
+    uint32_t implicitOrdinal_;    // Position among siblings with the same site key
     WeakPtr parent_;
     std::shared_ptr<Component> component_;
+    mutable uint64_t hash_;
+    mutable bool hashValid_;
+    mutable bool unhashedProps_;  // Set with hash_: props have values it ignores
+    mutable bool unhashedBelow_;  // The same for any node in the subtree
+    mutable StableId stableId_;  // 0 until assignStableIds() runs
+    bool frozen_;
+    bool hoisted_;
+    std::shared_ptr<Index> index_;  // Shared by every node of an indexed tree
+};
+
+// Derives the stable ids of one parent's children: call next() for each
+// non-null child, in order. Counts repeated keys so duplicate sibling keys
+// still get distinct ids; only keyed children are tracked.
+class ChildStableIds {
+public:
+    explicit ChildStableIds(StableId parent) : parent_(parent) {}
+    
+    StableId next(const VNode& child);
+    StableId parent() const { return parent_; }
+    
+private:
+    StableId parent_;
+    size_t index_ = 0;
+    std::unordered_map<std::string_view, size_t> keys_;  // Views into the children's keys
 };
 
 } // namespace reactpp
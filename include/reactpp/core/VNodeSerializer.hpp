@@ -0,0 +1,90 @@
+#pragma once
+
+#include "VNode.hpp"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace reactpp {
+
+// Compact binary encoding of VNode trees.
+//
+// A stream starts with a short header and holds any number of trees. Nodes
+// are written in pre-order with varint lengths and counts; tag and prop key
+// names are written once per stream and referenced by index afterwards.
+// Props of the built-in value types (int, uint32_t, float, double, bool,
+// std::string, gradient stops) are encoded. Other props, such as event
+// handlers, and Component instances cannot cross a process boundary and
+// are left out: component nodes come back without a component.
+
+// Streams trees to an std::ostream through a small internal buffer
+class VNodeWriter {
+public:
+    explicit VNodeWriter(std::ostream& out);
+    ~VNodeWriter();
+
+    VNodeWriter(const VNodeWriter&) = delete;
+    VNodeWriter& operator=(const VNodeWriter&) = delete;
+
+    // Append one tree to the stream
+    void write(const VNode& root);
+
+    // Push buffered bytes to the stream
+    void flush();
+
+    size_t bytesWritten() const { return written_ + buffer_.size(); }
+
+private:
+    void writeNode(const VNode& node);
+    void writeProps(const Props& props);
+    void writeName(std::unordered_map<uint32_t, uint32_t>& refs, uint32_t id, const std::string& name);
+    void putByte(uint8_t byte);
+    void putVarint(uint64_t value);
+    void putFixed(uint64_t value, size_t bytes);
+    void putString(std::string_view value);
+
+    std::ostream& out_;
+    std::string buffer_;
+    size_t written_;
+    std::unordered_map<uint32_t, uint32_t> tagRefs_;  // TagId -> stream index
+    std::unordered_map<uint32_t, uint32_t> keyRefs_;  // PropKey -> stream index
+};
+
+// Rebuilds trees straight from an encoded buffer. Strings are read in place
+// and names are interned once per stream. The buffer must outlive the reader.
+// Throws std::runtime_error on malformed or truncated input.
+class VNodeReader {
+public:
+    explicit VNodeReader(std::string_view data);
+
+    // Read the next tree in the stream
+    VNode::Ptr read();
+
+    bool atEnd() const { return pos_ == data_.size(); }
+
+private:
+    VNode::Ptr readNode(uint64_t& childCount);
+    void readProps(Props& props);
+    uint8_t getByte();
+    uint64_t getVarint();
+    uint64_t getFixed(size_t bytes);
+    std::string_view getString();
+    uint32_t getName(std::vector<uint32_t>& names, bool isTag);
+    void require(size_t bytes) const;
+
+    std::string_view data_;
+    size_t pos_;
+    std::vector<uint32_t> tags_;  // Stream index -> TagId
+    std::vector<uint32_t> keys_;  // Stream index -> PropKey
+};
+
+// Encode a single tree into a standalone buffer
+std::string encodeTree(const VNode& root);
+
+// Decode the first tree of a buffer written by encodeTree or VNodeWriter
+VNode::Ptr decodeTree(std::string_view data);
+
+} // namespace reactpp
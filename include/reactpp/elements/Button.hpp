@@ -2,27 +2,58 @@
 
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
 #include <string>
 #include <vector>
 #include <functional>
+#include <utility>
 
 namespace reactpp {
 namespace elements {
 
 // Button element
 inline VNode::Ptr Button(
-    const Props& props = Props(),
-    const std::vector<VNode::Ptr>& children = {}) {
-    return VNode::createElement("Button", props, children);
+    WithSite<Props> props = {},
+    std::vector<VNode::Ptr> children = {}) {
+    return props.keyed(VNode::createElement(tags::Button, std::move(props.value), std::move(children)));
+}
+
+template<typename... Children, typename = VNode::EnableIfChildren<Children...>>
+VNode::Ptr Button(WithSite<Props> props, Children&&... children) {
+    return props.keyed(VNode::createElement(tags::Button, std::move(props.value), std::forward<Children>(children)...));
 }
 
 // Convenience function for button with onClick
 inline VNode::Ptr Button(
-    std::function<void()> onClick,
-    const std::vector<VNode::Ptr>& children = {}) {
+    WithSite<std::function<void()>> onClick,
+    std::vector<VNode::Ptr> children = {}) {
+    Props props;
+    props.set(keys::onClick, std::move(onClick.value));
+    return onClick.keyed(VNode::createElement(tags::Button, std::move(props), std::move(children)));
+}
+
+template<typename... Children, typename = VNode::EnableIfChildren<Children...>>
+VNode::Ptr Button(WithSite<std::function<void()>> onClick, Children&&... children) {
+    Props props;
+    props.set(keys::onClick, std::move(onClick.value));
+    return onClick.keyed(VNode::createElement(tags::Button, std::move(props), std::forward<Children>(children)...));
+}
+
+// Button with a registered handler (see Component::addHandler)
+inline VNode::Ptr Button(
+    WithSite<EventHandle> onClick,
+    std::vector<VNode::Ptr> children = {}) {
+    Props props;
+    props.set(keys::onClick, onClick.value);
+    return onClick.keyed(VNode::createElement(tags::Button, std::move(props), std::move(children)));
+}
+
+template<typename... Children, typename = VNode::EnableIfChildren<Children...>>
+VNode::Ptr Button(WithSite<EventHandle> onClick, Children&&... children) {
     Props props;
-    props.set("onClick", onClick);
-    return VNode::createElement("Button", props, children);
+    props.set(keys::onClick, onClick.value);
+    return onClick.keyed(VNode::createElement(tags::Button, std::move(props), std::forward<Children>(children)...));
 }
 
 } // namespace elements
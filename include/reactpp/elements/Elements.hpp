@@ -6,4 +6,5 @@
 #include "Button.hpp"
 #include "Input.hpp"
 #include "PropsBuilder.hpp"
+#include "Template.hpp"
 
@@ -2,26 +2,40 @@
 
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
 #include <string>
 #include <functional>
+#include <utility>
 
 namespace reactpp {
 namespace elements {
 
 // Input element
-inline VNode::Ptr Input(const Props& props = Props()) {
-    return VNode::createElement("Input", props, {});
+inline VNode::Ptr Input(WithSite<Props> props = {}) {
+    return props.keyed(VNode::createElement(tags::Input, std::move(props.value)));
 }
 
 // Convenience function for input with onChange
 inline VNode::Ptr Input(
-    std::function<void(const std::string&)> onChange,
-    const std::string& value = "",
-    const Props& additionalProps = Props()) {
-    Props props = additionalProps;
-    props.set("onChange", onChange);
-    props.set("value", value);
-    return VNode::createElement("Input", props, {});
+    WithSite<std::function<void(const std::string&)>> onChange,
+    std::string value = "",
+    Props additionalProps = Props()) {
+    Props props = std::move(additionalProps);
+    props.set(keys::onChange, std::move(onChange.value));
+    props.set(keys::value, std::move(value));
+    return onChange.keyed(VNode::createElement(tags::Input, std::move(props)));
+}
+
+// Input with a registered handler (see Component::addHandler)
+inline VNode::Ptr Input(
+    WithSite<EventHandle> onChange,
+    std::string value = "",
+    Props additionalProps = Props()) {
+    Props props = std::move(additionalProps);
+    props.set(keys::onChange, onChange.value);
+    props.set(keys::value, std::move(value));
+    return onChange.keyed(VNode::createElement(tags::Input, std::move(props)));
 }
 
 } // namespace elements
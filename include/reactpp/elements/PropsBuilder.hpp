@@ -1,8 +1,10 @@
 #pragma once
 
+#include "reactpp/core/HandlerTable.hpp"
 #include "reactpp/core/Props.hpp"
 #include <functional>
 #include <string>
+#include <utility>
 
 namespace reactpp {
 namespace elements {
@@ -12,69 +14,101 @@ class PropsBuilder {
 public:
     PropsBuilder() {}
     
-    // Build the props object
-    Props build() const { return props_; }
+    // Build the props object (a temporary builder hands its props over)
+    Props build() const & { return props_; }
+    Props build() && { return std::move(props_); }
     
-    // Chainable setters for common props
-    PropsBuilder& onClick(std::function<void()> handler) {
-        props_.set("onClick", handler);
+    // Chainable setters for common props. Geometry and style setters write
+    // the typed BuiltinProps fields directly.
+    PropsBuilder& onClick(std::function<void()> handler) & {
+        props_.set(keys::onClick, std::move(handler));
         return *this;
     }
     
-    PropsBuilder& x(int value) {
-        props_.set("x", value);
+    PropsBuilder& onClick(EventHandle handler) & {
+        props_.set(keys::onClick, handler);
         return *this;
     }
     
-    PropsBuilder& y(int value) {
-        props_.set("y", value);
+    PropsBuilder& onChange(EventHandle handler) & {
+        props_.set(keys::onChange, handler);
         return *this;
     }
     
-    PropsBuilder& width(int value) {
-        props_.set("width", value);
+    PropsBuilder& x(int value) & {
+        props_.setBuiltin<BuiltinProps::X>(value);
         return *this;
     }
     
-    PropsBuilder& height(int value) {
-        props_.set("height", value);
+    PropsBuilder& y(int value) & {
+        props_.setBuiltin<BuiltinProps::Y>(value);
         return *this;
     }
     
-    PropsBuilder& backgroundColor(uint32_t color) {
-        props_.set("backgroundColor", color);
+    PropsBuilder& width(int value) & {
+        props_.setBuiltin<BuiltinProps::Width>(value);
         return *this;
     }
     
-    PropsBuilder& borderColor(uint32_t color) {
-        props_.set("borderColor", color);
+    PropsBuilder& height(int value) & {
+        props_.setBuiltin<BuiltinProps::Height>(value);
         return *this;
     }
     
-    PropsBuilder& color(uint32_t color) {
-        props_.set("color", color);
+    PropsBuilder& backgroundColor(uint32_t color) & {
+        props_.setBuiltin<BuiltinProps::BackgroundColor>(color);
         return *this;
     }
     
-    PropsBuilder& fontSize(int size) {
-        props_.set("fontSize", size);
+    PropsBuilder& borderColor(uint32_t color) & {
+        props_.setBuiltin<BuiltinProps::BorderColor>(color);
         return *this;
     }
     
-    PropsBuilder& borderWidth(int width) {
-        props_.set("borderWidth", width);
+    PropsBuilder& color(uint32_t color) & {
+        props_.setBuiltin<BuiltinProps::Color>(color);
+        return *this;
+    }
+    
+    PropsBuilder& fontSize(int size) & {
+        props_.setBuiltin<BuiltinProps::FontSize>(size);
+        return *this;
+    }
+    
+    PropsBuilder& borderWidth(int width) & {
+        props_.setBuiltin<BuiltinProps::BorderWidth>(width);
         return *this;
     }
     
     // Generic setter for any prop
     template<typename T>
-    PropsBuilder& set(const std::string& key, const T& value) {
-        props_.set(key, value);
+    PropsBuilder& set(const std::string& key, T&& value) & {
+        props_.set(key, std::forward<T>(value));
         return *this;
     }
     
+    // Rvalue overloads keep a temporary builder chain movable, so
+    // props().x(1).width(2) converts to Props without a copy
+    PropsBuilder&& onClick(std::function<void()> handler) && { return std::move(this->onClick(std::move(handler))); }
+    PropsBuilder&& onClick(EventHandle handler) && { return std::move(this->onClick(handler)); }
+    PropsBuilder&& onChange(EventHandle handler) && { return std::move(this->onChange(handler)); }
+    PropsBuilder&& x(int value) && { return std::move(this->x(value)); }
+    PropsBuilder&& y(int value) && { return std::move(this->y(value)); }
+    PropsBuilder&& width(int value) && { return std::move(this->width(value)); }
+    PropsBuilder&& height(int value) && { return std::move(this->height(value)); }
+    PropsBuilder&& backgroundColor(uint32_t color) && { return std::move(this->backgroundColor(color)); }
+    PropsBuilder&& borderColor(uint32_t color) && { return std::move(this->borderColor(color)); }
+    PropsBuilder&& color(uint32_t color) && { return std::move(this->color(color)); }
+    PropsBuilder&& fontSize(int size) && { return std::move(this->fontSize(size)); }
+    PropsBuilder&& borderWidth(int width) && { return std::move(this->borderWidth(width)); }
+    template<typename T>
+    PropsBuilder&& set(const std::string& key, T&& value) && {
+        return std::move(this->set(key, std::forward<T>(value)));
+    }
+    
     // Implicit conversion to Props
-    operator Props() const { return props_; }
+    operator Props() const & { return props_; }
+    operator Props() && { return std::move(props_); }
 
 private:
     Props props_;
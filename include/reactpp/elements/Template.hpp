@@ -0,0 +1,402 @@
+#pragma once
+
+#include "reactpp/core/BuiltinProps.hpp"
+#include "reactpp/core/NodeBlock.hpp"
+#include "reactpp/core/Props.hpp"
+#include "reactpp/core/VNode.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace reactpp {
+namespace elements {
+
+// Compile-time element trees.
+//
+// A template describes a tree of fixed structure as a constexpr value built
+// from the tmpl factories, which mirror View/Button/Text/Input:
+//
+//     constexpr auto Card = tmpl::View(tmpl::props().width(300).height(80),
+//         tmpl::Text(tmpl::slot<0>, tmpl::props().fontSize(18)),
+//         tmpl::Button(tmpl::props().bind<1>(keys::onClick), tmpl::Text("Open")));
+//
+//     static const TreeTemplate card(Card);
+//     auto node = card(title, openHandle);
+//
+// Props are typed (the BuiltinProps fields). Dynamic parts are slots filled
+// from the call arguments by position: slot<I> as a child takes a
+// VNode::Ptr, as the content of a Text a string, and bind<I>(key) sets a
+// prop to argument I. tmpl::flatten() turns a description into pre-order
+// arrays at compile time.
+namespace tmpl {
+
+template<size_t I>
+struct Slot {
+    static constexpr size_t index = I;
+};
+
+template<size_t I>
+inline constexpr Slot<I> slot{};
+
+// Prop set from a call argument
+struct Binding {
+    PropKey key;
+    uint16_t slot = 0;
+};
+
+// Typed static props plus B slot bindings, which use slots below S
+template<size_t B, size_t S = 0>
+struct Props {
+    static constexpr size_t bindingCount = B;
+    static constexpr size_t slotCount = S;
+
+    BuiltinProps builtins;
+    std::array<Binding, B> bindings{};
+
+    constexpr Props x(int value) const { return with<BuiltinProps::X>(value); }
+    constexpr Props y(int value) const { return with<BuiltinProps::Y>(value); }
+    constexpr Props width(int value) const { return with<BuiltinProps::Width>(value); }
+    constexpr Props height(int value) const { return with<BuiltinProps::Height>(value); }
+    constexpr Props backgroundColor(uint32_t color) const { return with<BuiltinProps::BackgroundColor>(color); }
+    constexpr Props borderColor(uint32_t color) const { return with<BuiltinProps::BorderColor>(color); }
+    constexpr Props color(uint32_t color) const { return with<BuiltinProps::Color>(color); }
+    constexpr Props fontSize(int size) const { return with<BuiltinProps::FontSize>(size); }
+    constexpr Props borderWidth(int width) const { return with<BuiltinProps::BorderWidth>(width); }
+
+    // Set key from argument I on every instantiation
+    template<size_t I>
+    constexpr Props<B + 1, std::max(S, I + 1)> bind(PropKey key) const {
+        Props<B + 1, std::max(S, I + 1)> result{builtins, {}};
+        for (size_t i = 0; i < B; ++i) {
+            result.bindings[i] = bindings[i];
+        }
+        result.bindings[B] = Binding{key, static_cast<uint16_t>(I)};
+        return result;
+    }
+
+    template<BuiltinProps::Field F>
+    constexpr Props with(BuiltinProps::Type<F> value) const {
+        Props result = *this;
+        result.builtins.template set<F>(value);
+        return result;
+    }
+};
+
+constexpr Props<0> props() { return {}; }
+
+// Node kinds of a flattened template
+enum class NodeKind : uint8_t {
+    Element,
+    Text,
+    TextSlot,
+    ChildSlot
+};
+
+// Description nodes. nodeCount, bindingCount and slotCount (one past the
+// highest slot index) are known at compile time.
+template<typename P, typename... Children>
+struct Element {
+    static constexpr NodeKind kind = NodeKind::Element;
+    static constexpr size_t nodeCount = 1 + (size_t{0} + ... + Children::nodeCount);
+    static constexpr size_t bindingCount = P::bindingCount + (size_t{0} + ... + Children::bindingCount);
+    static constexpr size_t slotCount = std::max({P::slotCount, Children::slotCount...});
+
+    TagId tag;
+    P props;
+    std::tuple<Children...> children;
+};
+
+template<typename P>
+struct TextNode {
+    static constexpr NodeKind kind = NodeKind::Text;
+    static constexpr size_t nodeCount = 1;
+    static constexpr size_t bindingCount = P::bindingCount;
+    static constexpr size_t slotCount = P::slotCount;
+
+    std::string_view text;
+    P props;
+};
+
+template<size_t I, typename P>
+struct TextSlot {
+    static constexpr NodeKind kind = NodeKind::TextSlot;
+    static constexpr size_t nodeCount = 1;
+    static constexpr size_t bindingCount = P::bindingCount;
+    static constexpr size_t slotCount = std::max(P::slotCount, I + 1);
+    static constexpr size_t slotIndex = I;
+
+    P props;
+};
+
+template<size_t I>
+struct ChildSlot {
+    static constexpr NodeKind kind = NodeKind::ChildSlot;
+    static constexpr size_t nodeCount = 1;
+    static constexpr size_t bindingCount = 0;
+    static constexpr size_t slotCount = I + 1;
+    static constexpr size_t slotIndex = I;
+};
+
+namespace detail {
+
+template<typename Node>
+constexpr Node asChild(Node node) { return node; }
+
+template<size_t I>
+constexpr ChildSlot<I> asChild(Slot<I>) { return {}; }
+
+} // namespace detail
+
+template<size_t B, size_t S, typename... Children>
+constexpr auto View(Props<B, S> props, Children... children) {
+    return Element<Props<B, S>, decltype(detail::asChild(children))...>{
+        tags::View, props, {detail::asChild(children)...}};
+}
+
+template<size_t B, size_t S, typename... Children>
+constexpr auto Button(Props<B, S> props, Children... children) {
+    return Element<Props<B, S>, decltype(detail::asChild(children))...>{
+        tags::Button, props, {detail::asChild(children)...}};
+}
+
+template<size_t B, size_t S>
+constexpr auto Input(Props<B, S> props) {
+    return Element<Props<B, S>>{tags::Input, props, {}};
+}
+
+constexpr TextNode<Props<0>> Text(std::string_view text) {
+    return {text, {}};
+}
+
+template<size_t B, size_t S>
+constexpr TextNode<Props<B, S>> Text(std::string_view text, Props<B, S> props) {
+    return {text, props};
+}
+
+template<size_t I>
+constexpr TextSlot<I, Props<0>> Text(Slot<I>) {
+    return {{}};
+}
+
+template<size_t I, size_t B, size_t S>
+constexpr TextSlot<I, Props<B, S>> Text(Slot<I>, Props<B, S> props) {
+    return {props};
+}
+
+// One pre-order row of a flattened template
+struct FlatNode {
+    NodeKind kind = NodeKind::Element;
+    TagId tag;
+    std::string_view text;
+    BuiltinProps builtins;
+    uint16_t childCount = 0;
+    uint16_t slot = 0;          // TextSlot and ChildSlot
+    uint16_t firstBinding = 0;  // Range in FlatTree::bindings
+    uint16_t bindingCount = 0;
+};
+
+template<size_t N, size_t M>
+struct FlatTree {
+    std::array<FlatNode, N> nodes{};
+    std::array<Binding, M> bindings{};
+};
+
+namespace detail {
+
+template<typename P, size_t M>
+constexpr void addProps(const P& props, FlatNode& row, std::array<Binding, M>& bindings, size_t& bindingIndex) {
+    row.builtins = props.builtins;
+    row.firstBinding = static_cast<uint16_t>(bindingIndex);
+    row.bindingCount = static_cast<uint16_t>(P::bindingCount);
+    for (size_t i = 0; i < P::bindingCount; ++i) {
+        bindings[bindingIndex++] = props.bindings[i];
+    }
+}
+
+template<typename Node, size_t N, size_t M>
+constexpr void flattenInto(const Node& node, FlatTree<N, M>& tree, size_t& nodeIndex, size_t& bindingIndex) {
+    FlatNode& row = tree.nodes[nodeIndex++];
+    row.kind = Node::kind;
+    if constexpr (Node::kind == NodeKind::Element) {
+        row.tag = node.tag;
+        row.childCount = static_cast<uint16_t>(std::tuple_size_v<decltype(node.children)>);
+        addProps(node.props, row, tree.bindings, bindingIndex);
+        std::apply([&](const auto&... children) {
+            (flattenInto(children, tree, nodeIndex, bindingIndex), ...);
+        }, node.children);
+    } else if constexpr (Node::kind == NodeKind::Text) {
+        row.text = node.text;
+        addProps(node.props, row, tree.bindings, bindingIndex);
+    } else if constexpr (Node::kind == NodeKind::TextSlot) {
+        row.slot = static_cast<uint16_t>(Node::slotIndex);
+        addProps(node.props, row, tree.bindings, bindingIndex);
+    } else {
+        row.slot = static_cast<uint16_t>(Node::slotIndex);
+    }
+}
+
+} // namespace detail
+
+// Pre-order arrays for a description; usable in constant expressions
+template<typename Root>
+constexpr FlatTree<Root::nodeCount, Root::bindingCount> flatten(const Root& root) {
+    FlatTree<Root::nodeCount, Root::bindingCount> tree{};
+    size_t nodeIndex = 0;
+    size_t bindingIndex = 0;
+    detail::flattenInto(root, tree, nodeIndex, bindingIndex);
+    return tree;
+}
+
+} // namespace tmpl
+
+// Instantiates a template description into VNodes.
+//
+// Construction flattens the description and builds each node's static Props
+// once; instances share them by reference count. Each call allocates every
+// node, control block and children array of the tree from one NodeBlock,
+// sized from the previous call's actual use. Text longer than the string's
+// inline buffer, bound props and slot arguments allocate on their own.
+// Calls may run concurrently.
+template<typename Root>
+class TreeTemplate {
+public:
+    static constexpr size_t NodeCount = Root::nodeCount;
+
+    static constexpr size_t SlotCount = Root::slotCount;
+
+    explicit TreeTemplate(const Root& root)
+        : flat_(tmpl::flatten(root)) {
+        // First guess at the block size; calls then size it from actual use
+        size_t estimate = 0;
+        for (size_t i = 0; i < NodeCount; ++i) {
+            const tmpl::FlatNode& row = flat_.nodes[i];
+            props_[i].setBuiltins(row.builtins);
+            estimate += sizeof(VNode) + 64 + row.childCount * sizeof(VNode::Ptr);
+        }
+        blockSize_.store(estimate, std::memory_order_relaxed);
+    }
+
+    // Build a tree; arguments fill the slots by position
+    template<typename... Args>
+    VNode::Ptr operator()(Args&&... args) const {
+        static_assert(sizeof...(Args) == SlotCount, "TreeTemplate: one argument per slot");
+        auto arguments = std::forward_as_tuple(args...);
+
+        NodeBlock* block = NodeBlock::create(blockSize_.load(std::memory_order_relaxed));
+        VNode::Ptr root;
+        try {
+            NodeBlock::Scope scope(*block);
+            root = build(arguments);
+        } catch (...) {
+            block->release();
+            throw;
+        }
+        blockSize_.store(block->bytesRequested(), std::memory_order_relaxed);
+        block->release();
+        return root;
+    }
+
+    const tmpl::FlatTree<Root::nodeCount, Root::bindingCount>& flat() const { return flat_; }
+
+private:
+    template<typename Tuple>
+    VNode::Ptr build(Tuple& arguments) const {
+        struct Open {
+            VNode* node;
+            uint16_t remaining;
+        };
+        std::array<Open, NodeCount> stack;
+        size_t depth = 0;
+        VNode::Ptr root;
+
+        for (size_t i = 0; i < NodeCount; ++i) {
+            const tmpl::FlatNode& row = flat_.nodes[i];
+            VNode::Ptr node = createNode(row, props_[i], arguments);
+
+            if (depth == 0) {
+                root = node;
+            } else {
+                Open& parent = stack[depth - 1];
+                parent.node->appendChild(node);
+                --parent.remaining;
+            }
+            if (row.kind == tmpl::NodeKind::Element && row.childCount > 0) {
+                node->getChildren().reserve(row.childCount);
+                stack[depth++] = {node.get(), row.childCount};
+            }
+            while (depth > 0 && stack[depth - 1].remaining == 0) {
+                --depth;
+            }
+        }
+        return root;
+    }
+
+    template<typename Tuple>
+    VNode::Ptr createNode(const tmpl::FlatNode& row, const Props& staticProps, Tuple& arguments) const {
+        Props props = staticProps;
+        for (uint16_t b = 0; b < row.bindingCount; ++b) {
+            const tmpl::Binding& binding = flat_.bindings[row.firstBinding + b];
+            withArgument(arguments, binding.slot, [&](const auto& value) {
+                props.set(binding.key, value);
+            });
+        }
+
+        switch (row.kind) {
+            case tmpl::NodeKind::Element:
+                return VNode::createElement(row.tag, std::move(props));
+            case tmpl::NodeKind::Text:
+                return VNode::createText(std::string(row.text), std::move(props));
+            case tmpl::NodeKind::TextSlot: {
+                VNode::Ptr node;
+                withArgument(arguments, row.slot, [&](const auto& value) {
+                    using T = std::decay_t<decltype(value)>;
+                    if constexpr (std::is_convertible_v<const T&, std::string>) {
+                        node = VNode::createText(std::string(value), std::move(props));
+                    } else {
+                        throw std::runtime_error("TreeTemplate: slot " + std::to_string(row.slot) + " must be text");
+                    }
+                });
+                return node;
+            }
+            case tmpl::NodeKind::ChildSlot: {
+                VNode::Ptr node;
+                withArgument(arguments, row.slot, [&](const auto& value) {
+                    using T = std::decay_t<decltype(value)>;
+                    if constexpr (std::is_convertible_v<const T&, VNode::Ptr>) {
+                        node = value;
+                    } else {
+                        throw std::runtime_error("TreeTemplate: slot " + std::to_string(row.slot) + " must be a VNode");
+                    }
+                });
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    // Call fn with the argument at a runtime index
+    template<typename Tuple, typename Fn>
+    static void withArgument(Tuple& arguments, size_t index, Fn&& fn) {
+        withArgument(arguments, index, fn, std::make_index_sequence<std::tuple_size_v<Tuple>>());
+    }
+
+    template<typename Tuple, typename Fn, size_t... Is>
+    static void withArgument(Tuple& arguments, size_t index, Fn& fn, std::index_sequence<Is...>) {
+        ((index == Is ? (fn(std::get<Is>(arguments)), 0) : 0), ...);
+    }
+
+    tmpl::FlatTree<Root::nodeCount, Root::bindingCount> flat_;
+    std::array<Props, NodeCount> props_;
+    mutable std::atomic<size_t> blockSize_{0};
+};
+
+} // namespace elements
+} // namespace reactpp
@@ -2,23 +2,18 @@
 
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
 #include <string>
+#include <utility>
 
 namespace reactpp {
 namespace elements {
 
-// Text element
-inline VNode::Ptr Text(const std::string& content, const Props& props = Props()) {
-    auto textNode = VNode::createText(content);
-    if (!props.empty()) {
-        // For text nodes, we can store additional props in a wrapper element
-        // or extend VNode to support props on text nodes
-        auto wrapper = VNode::createElement("Text", props, {textNode});
-        return wrapper;
-    }
-    return textNode;
+// Text element: a single text node carrying its own props (color,
+// fontSize, x, y, onClick, ...)
+inline VNode::Ptr Text(std::string content, WithSite<Props> props = {}) {
+    return props.keyed(VNode::createText(std::move(content), std::move(props.value)));
 }
 
 } // namespace elements
 } // namespace reactpp
-
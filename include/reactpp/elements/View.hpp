@@ -2,19 +2,29 @@
 
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
 #include <string>
 #include <vector>
+#include <utility>
 
 namespace reactpp {
 namespace elements {
 
+// Element factories take their first argument through WithSite, which
+// records the caller's location for implicit keys (see ImplicitKeys).
+
 // View - Container element
 inline VNode::Ptr View(
-    const Props& props = Props(),
-    const std::vector<VNode::Ptr>& children = {}) {
-    return VNode::createElement("View", props, children);
+    WithSite<Props> props = {},
+    std::vector<VNode::Ptr> children = {}) {
+    return props.keyed(VNode::createElement(tags::View, std::move(props.value), std::move(children)));
+}
+
+// View with children passed directly: View(props, a, b, c)
+template<typename... Children, typename = VNode::EnableIfChildren<Children...>>
+VNode::Ptr View(WithSite<Props> props, Children&&... children) {
+    return props.keyed(VNode::createElement(tags::View, std::move(props.value), std::forward<Children>(children)...));
 }
 
 } // namespace elements
 } // namespace reactpp
-
@@ -19,24 +19,29 @@ struct HandlerKeyHash {
     }
 };
 
+// Handlers are keyed by VNode stable id (VNode::getStableId), so a handler
+// registered against one render still applies to the same node in the next.
 class EventManager {
 public:
     EventManager();
     
     // Register event handler for VNode
-    void registerHandler(uint64_t nodeId, const std::string& eventType, EventDispatcher::Handler handler);
+    void registerHandler(StableId stableId, const std::string& eventType, EventDispatcher::Handler handler);
     
     // Remove event handler
-    void unregisterHandler(uint64_t nodeId, const std::string& eventType);
+    void unregisterHandler(StableId stableId, const std::string& eventType);
     
     // Get handlers for node and event type
-    std::vector<EventDispatcher::Handler> getHandlers(uint64_t nodeId, const std::string& eventType) const;
+    std::vector<EventDispatcher::Handler> getHandlers(StableId stableId, const std::string& eventType) const;
     
     // Cleanup handlers for node
-    void cleanupNode(uint64_t nodeId);
+    void cleanupNode(StableId stableId);
+    
+    // Drop handlers of nodes that are no longer in the tree under root
+    void retainTree(VNode::Ptr root);
     
 private:
-    using HandlerKey = std::pair<uint64_t, std::string>;
+    using HandlerKey = std::pair<StableId, std::string>;
     std::unordered_map<HandlerKey, std::vector<EventDispatcher::Handler>, HandlerKeyHash> handlers_;
 };
 
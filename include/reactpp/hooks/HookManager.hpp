@@ -37,10 +37,17 @@ public:
     void validateHookCall(size_t expectedIndex);
     
     // Mark as dirty (needs re-render)
-    void markDirty() { dirty_ = true; }
+    void markDirty() { dirty_ = true; ++marks_; }
     bool isDirty() const { return dirty_; }
     void clearDirty() { dirty_ = false; }
     
+    // markDirty() calls so far. A render that started after `seen` marks
+    // clears the flag at commit only if no mark came in since.
+    uint64_t markCount() const { return marks_; }
+    void clearDirty(uint64_t seen) {
+        if (marks_ == seen) dirty_ = false;
+    }
+    
     // Component association
     void setComponentId(uint64_t id) { componentId_ = id; }
     uint64_t getComponentId() const { return componentId_; }
@@ -49,6 +56,7 @@ private:
     std::vector<std::any> hooks_;
     size_t currentIndex_;
     bool dirty_;
+    uint64_t marks_;
     uint64_t componentId_;
 };
 
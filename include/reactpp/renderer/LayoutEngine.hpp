@@ -2,6 +2,7 @@
 
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/renderer/RendererTypes.hpp"
+#include "reactpp/renderer/NodeTable.hpp"
 #include <cstdint>
 #include <unordered_map>
 
@@ -31,15 +32,26 @@ class LayoutEngine {
 public:
     LayoutEngine();
     
-    // Calculate layout for VNode tree
+    // Calculate layout for VNode tree (snapshots it into a NodeTable first)
     void calculateLayout(VNode::Ptr root, int containerWidth, int containerHeight);
     
-    // Get computed layout for node
-    Rect getLayout(uint64_t nodeId) const;
+    // Calculate layout in place over a node table: one forward pass in
+    // pre-order, writing table.layouts(). Follows the renderers' block
+    // layout: Views stack their children vertically (text drawn 20px below
+    // the cursor), Buttons default to 150x40 and center their text, and
+    // text size is estimated from the font size.
+    void calculateLayout(NodeTable& table, int containerWidth, int containerHeight);
+    
+    // Get computed layout for node by stable id (VNode::getStableId), so
+    // lookups made with the next render's nodes still hit
+    Rect getLayout(StableId stableId) const;
+    
+    // Table built by the last VNode-based calculateLayout
+    const NodeTable& getNodeTable() const { return table_; }
     
 private:
-    void layoutNode(VNode::Ptr node, int availableWidth, int availableHeight);
-    std::unordered_map<uint64_t, Rect> layouts_;
+    NodeTable table_;
+    std::unordered_map<StableId, Rect> layouts_;  // Keyed by stable id
 };
 
 } // namespace renderer
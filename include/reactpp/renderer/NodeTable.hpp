@@ -0,0 +1,161 @@
+#pragma once
+
+#include "reactpp/core/VNode.hpp"
+#include "reactpp/renderer/RendererTypes.hpp"
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace reactpp {
+namespace renderer {
+
+using NodeIndex = uint32_t;
+constexpr NodeIndex InvalidNode = std::numeric_limits<NodeIndex>::max();
+
+// Geometry requested through props; Auto where not set
+struct LayoutSpec {
+    static constexpr int Auto = INT_MIN;
+
+    int x = Auto;
+    int y = Auto;
+    int width = Auto;
+    int height = Auto;
+};
+
+// Paint style resolved once per node when the table is built.
+// Text nodes inherit the style of their parent, overridden by their own
+// color and fontSize.
+struct NodeStyle {
+    uint32_t backgroundColor = 0x00000000;
+    uint32_t borderColor = 0x000000FF;
+    uint32_t color = 0x000000FF;
+    int fontSize = 16;
+    int borderWidth = 0;
+};
+
+class NodeTable;
+
+// Lightweight reference to a row of a NodeTable. Copy freely; valid until
+// the table is rebuilt or cleared.
+class NodeHandle {
+public:
+    NodeHandle() : table_(nullptr), index_(InvalidNode) {}
+    NodeHandle(const NodeTable* table, NodeIndex index) : table_(table), index_(index) {}
+
+    bool valid() const { return table_ && index_ != InvalidNode; }
+    explicit operator bool() const { return valid(); }
+    NodeIndex index() const { return index_; }
+
+    VNodeType type() const;
+    TagId tag() const;
+    uint64_t vnodeId() const;
+    StableId stableId() const;
+    std::string_view text() const;
+    const LayoutSpec& spec() const;
+    const NodeStyle& style() const;
+    const Rect& layout() const;
+    const VNode& vnode() const;
+
+    NodeHandle parent() const;
+    NodeHandle firstChild() const;
+    NodeHandle nextSibling() const;
+
+    bool operator==(const NodeHandle& other) const {
+        return table_ == other.table_ && index_ == other.index_;
+    }
+    bool operator!=(const NodeHandle& other) const { return !(*this == other); }
+
+private:
+    const NodeTable* table_;
+    NodeIndex index_;
+};
+
+// Structure-of-arrays snapshot of a VNode tree.
+//
+// Rows are stored in pre-order, so a parent always precedes its children
+// and a subtree occupies the contiguous range [i, subtreeEnd(i)). Full-tree
+// passes can therefore run as linear scans over the columns they need:
+// top-down passes iterate forward, bottom-up passes iterate backward.
+//
+// Text columns view into the VNodes, which must outlive the table.
+class NodeTable {
+public:
+    NodeTable() = default;
+    explicit NodeTable(const VNode& root) { build(root); }
+
+    // Replace the contents with a snapshot of the tree under root
+    void build(const VNode& root);
+    void clear();
+
+    size_t size() const { return types_.size(); }
+    bool empty() const { return types_.empty(); }
+
+    NodeHandle root() const { return handle(empty() ? InvalidNode : 0); }
+    NodeHandle handle(NodeIndex index) const { return NodeHandle(this, index); }
+
+    // Row of the node with the given VNode id (linear scan over one column)
+    NodeHandle find(uint64_t vnodeId) const;
+
+    // Columns
+    const std::vector<VNodeType>& types() const { return types_; }
+    const std::vector<TagId>& tags() const { return tags_; }
+    const std::vector<uint64_t>& vnodeIds() const { return vnodeIds_; }
+    const std::vector<StableId>& stableIds() const { return stableIds_; }  // See VNode::getStableId
+    const std::vector<std::string_view>& texts() const { return texts_; }
+    const std::vector<NodeIndex>& parents() const { return parents_; }
+    const std::vector<NodeIndex>& firstChildren() const { return firstChildren_; }
+    const std::vector<NodeIndex>& nextSiblings() const { return nextSiblings_; }
+    const std::vector<NodeIndex>& subtreeEnds() const { return subtreeEnds_; }
+    const std::vector<LayoutSpec>& specs() const { return specs_; }
+    const std::vector<NodeStyle>& styles() const { return styles_; }
+    const std::vector<Rect>& layouts() const { return layouts_; }
+    std::vector<Rect>& layouts() { return layouts_; }  // Written by the layout engine
+
+    NodeIndex subtreeEnd(NodeIndex index) const { return subtreeEnds_[index]; }
+    const VNode& vnode(NodeIndex index) const { return *sources_[index]; }
+
+private:
+    NodeIndex append(const VNode& node, NodeIndex parent, StableId stableId);
+
+    std::vector<VNodeType> types_;
+    std::vector<TagId> tags_;
+    std::vector<uint64_t> vnodeIds_;
+    std::vector<StableId> stableIds_;
+    std::vector<std::string_view> texts_;
+    std::vector<NodeIndex> parents_;
+    std::vector<NodeIndex> firstChildren_;
+    std::vector<NodeIndex> nextSiblings_;
+    std::vector<NodeIndex> subtreeEnds_;
+    std::vector<LayoutSpec> specs_;
+    std::vector<NodeStyle> styles_;
+    std::vector<Rect> layouts_;
+    std::vector<const VNode*> sources_;
+    std::vector<NodeIndex> lastChildren_;  // Only used while building
+};
+
+inline VNodeType NodeHandle::type() const { return table_->types()[index_]; }
+inline TagId NodeHandle::tag() const { return table_->tags()[index_]; }
+inline uint64_t NodeHandle::vnodeId() const { return table_->vnodeIds()[index_]; }
+inline StableId NodeHandle::stableId() const { return table_->stableIds()[index_]; }
+inline std::string_view NodeHandle::text() const { return table_->texts()[index_]; }
+inline const LayoutSpec& NodeHandle::spec() const { return table_->specs()[index_]; }
+inline const NodeStyle& NodeHandle::style() const { return table_->styles()[index_]; }
+inline const Rect& NodeHandle::layout() const { return table_->layouts()[index_]; }
+inline const VNode& NodeHandle::vnode() const { return table_->vnode(index_); }
+
+inline NodeHandle NodeHandle::parent() const {
+    return NodeHandle(table_, table_->parents()[index_]);
+}
+
+inline NodeHandle NodeHandle::firstChild() const {
+    return NodeHandle(table_, table_->firstChildren()[index_]);
+}
+
+inline NodeHandle NodeHandle::nextSibling() const {
+    return NodeHandle(table_, table_->nextSiblings()[index_]);
+}
+
+} // namespace renderer
+} // namespace reactpp
@@ -3,7 +3,9 @@
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/FiberNode.hpp"
 #include "LayoutEngine.hpp"
+#include "StyleResolver.hpp"
 #include <unordered_map>
+#include <vector>
 
 namespace reactpp {
 namespace renderer {
@@ -20,22 +22,46 @@ public:
 
 class RenderTree {
 public:
-    RenderTree();
+    RenderTree(int viewportWidth = 800, int viewportHeight = 600);
     
-    // Update render tree from VNode tree
+    // Update render tree from VNode tree. Render nodes are keyed by stable
+    // id (VNode::getStableId): a node at the same place as in the previous
+    // update keeps its RenderTreeNode and is only marked for repaint if its
+    // layout, styles or content changed. Nodes that left the tree are dropped.
+    // A hoisted subtree (VNode::hoist) found again at the same place with
+    // the same styles and layout is skipped without touching its nodes.
     void update(VNode::Ptr root);
     
+    void setViewportSize(int width, int height);
+    
     // Mark dirty for layout
-    void markDirty(uint64_t nodeId);
+    void markDirty(StableId stableId);
     
     // Get render node
-    std::shared_ptr<RenderTreeNode> getNode(uint64_t nodeId) const;
+    std::shared_ptr<RenderTreeNode> getNode(StableId stableId) const;
+    
+    size_t size() const { return nodes_.size(); }
     
 private:
-    std::unordered_map<uint64_t, std::shared_ptr<RenderTreeNode>> nodes_;
+    // What a hoisted subtree looked like when it was last updated
+    struct HoistedSubtree {
+        const VNode* source = nullptr;
+        uint64_t hash = 0;
+        std::vector<Rect> layouts;  // Pre-order, root first
+    };
+    
+    // True if the hoisted subtree at index is unchanged since the last
+    // update; records it otherwise
+    bool skipHoisted(const NodeTable& table, NodeIndex index,
+                     const RenderTreeNode* node, const Props* styles);
+    
+    std::unordered_map<StableId, std::shared_ptr<RenderTreeNode>> nodes_;
+    std::unordered_map<StableId, HoistedSubtree> hoisted_;  // Keyed by stable id
     LayoutEngine layoutEngine_;
+    StyleResolver styleResolver_;
+    int viewportWidth_;
+    int viewportHeight_;
 };
 
 } // namespace renderer
 } // namespace reactpp
-
@@ -102,15 +102,20 @@ private:
     bool ttfInitialized_;
     bool hideCursorOnTouch_;
     
-    // Element layout tracking for hit testing
-    std::unordered_map<uint64_t, Rect> elementLayouts_;
+    // Element layout tracking for hit testing, keyed by VNode stable id
+    std::unordered_map<StableId, Rect> elementLayouts_;
     
     bool initializeSDL();
     void cleanup();
     TTF_Font* loadFont(const std::string& fontPath, int fontSize);
     void renderVNode(VNode::Ptr node, int offsetX = 0, int offsetY = 0);
+    // Draw a text node at (x, y), or centered on it. The node's own props
+    // win over the inherited ones; records its bounds for hit testing if it
+    // has onClick. Returns the drawn bounds.
+    Rect renderText(const VNode& node, const Props& inherited, int x, int y,
+                    uint32_t defaultColor, int defaultFontSize, bool centered);
     VNode::Ptr findElementAtRecursive(int x, int y, VNode::Ptr node);
-    uint32_t getColorFromProps(const Props& props, const std::string& key, uint32_t defaultColor = 0xFFFFFFFF);
+    uint32_t getColorFromProps(const Props& props, PropKey key, uint32_t defaultColor = 0xFFFFFFFF);
     Rect getRectFromProps(const Props& props, const Rect& defaultRect);
 };
 
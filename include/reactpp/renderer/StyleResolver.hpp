@@ -2,6 +2,7 @@
 
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 
@@ -12,17 +13,51 @@ class StyleResolver {
 public:
     StyleResolver();
     
-    // Resolve styles for VNode
+    // Resolve styles for VNode: the defaults, then color and fontSize
+    // inherited from the parent, then the node's own style props. Served
+    // from the cache when the last computeStyles already resolved the node.
     Props resolveStyles(VNode::Ptr node);
     
-    // Compute final style values
+    // Compute final style values for the tree under node. Results are cached
+    // by stable id (VNode::getStableId) and reused on the next pass when
+    // neither the node's props nor its inherited styles changed. Entries of
+    // nodes that are no longer in the tree are dropped. A hoisted subtree
+    // (VNode::hoist) found again at the same place under the same inherited
+    // styles is skipped as a whole.
     void computeStyles(VNode::Ptr node);
     
+    // Styles computed for a node by the last computeStyles, or nullptr
+    const Props* getComputedStyles(StableId stableId) const;
+    
+    size_t cacheSize() const { return computedStyles_.size(); }
+    size_t reusedCount() const { return reused_; }    // Entries the last pass reused
+    size_t skippedCount() const { return skipped_; }  // Hoisted subtrees the last pass skipped
+    
 private:
+    struct Entry {
+        uint64_t inputHash = 0;   // Own props (handlers excluded) and inherited styles
+        uint64_t stylesHash = 0;  // Passed on to children as their inherited input
+        uint64_t generation = 0;
+        Props styles;
+        
+        // Hoisted subtrees: scope is the stable id of the innermost hoisted
+        // root containing the node (0 if none). Hoisted roots also record
+        // their node, the scope around them and the pass that last skipped them.
+        StableId scope = 0;
+        StableId outerScope = 0;
+        const VNode* hoisted = nullptr;
+        uint64_t hoistedHash = 0;
+        uint64_t skipped = 0;
+    };
+    
+    Props compute(const Props& own, const Props* inherited) const;
+    
     Props defaultStyles_;
-    std::unordered_map<uint64_t, Props> computedStyles_;
+    std::unordered_map<StableId, Entry> computedStyles_;
+    uint64_t generation_;
+    size_t reused_;
+    size_t skipped_;
 };
 
 } // namespace renderer
 } // namespace reactpp
-
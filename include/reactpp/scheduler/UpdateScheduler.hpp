@@ -18,6 +18,11 @@ public:
     // Process updates
     void processUpdates();
     
+    // Highest-priority update (oldest first within a priority), removed
+    // from the queue; null if none is pending
+    FiberNode::Ptr takeUpdate();
+    bool hasPendingUpdates() const { return !updateQueue_.empty(); }
+    
     // Batch updates
     void batchUpdates(std::function<void()> fn);
     
@@ -41,6 +46,7 @@ private:
     std::priority_queue<Update> updateQueue_;
     std::vector<std::function<void()>> batchedUpdates_;
     bool batching_;
+    uint64_t nextTimestamp_;  // Orders updates of equal priority
 };
 
 } // namespace reactpp
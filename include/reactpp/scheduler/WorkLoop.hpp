@@ -1,31 +1,70 @@
 #pragma once
 
 #include "reactpp/core/FiberNode.hpp"
+#include "reactpp/core/Reconciler.hpp"
 #include "UpdateScheduler.hpp"
+#include <cstdint>
 #include <functional>
 
 namespace reactpp {
 
+// Time-sliced reconciliation.
+//
+// Each run() is one tick: it reconciles fibers one unit at a time until
+// the frame budget is spent, then yields, picking up where it stopped on
+// the next tick. A finished tree is committed in one step, so the commit
+// callback never sees a partial tree.
+//
+// Updates come from the scheduler: a fiber whose vnode is the tree to
+// render and whose alternate, if set, holds the tree it replaces (else the
+// last committed tree). They are rendered in priority order, one at a time;
+// an update scheduled mid-render waits for that render's commit.
 class WorkLoop {
 public:
-    WorkLoop(std::shared_ptr<UpdateScheduler> scheduler);
-    
-    // Main work loop
-    void run();
+    using Clock = std::function<uint64_t()>;  // Monotonic milliseconds
+    using CommitHandler = std::function<void(const FiberNode::Ptr& root)>;
+
+    WorkLoop(std::shared_ptr<UpdateScheduler> scheduler, Clock clock = nullptr);
+
+    // Queue a render of next
+    void schedule(VNode::Ptr next, Priority priority = Priority::Normal);
+
+    // Called with each finished tree (effects in root->effectList)
+    void onCommit(CommitHandler handler) { commit_ = std::move(handler); }
+
+    // Main work loop: one tick. Returns true if work remains.
+    bool run();
+
+    // Drop the render in progress; nothing is committed
     void stop();
-    
-    // Process single unit of work
-    bool work(FiberNode::Ptr fiber);
-    
-    // Check if should yield
+
+    // Process single unit of work. Returns false if none is left.
+    bool work();
+
+    // True once this tick has used its frame budget
     bool shouldYield() const;
-    
+
+    void setFrameBudget(uint64_t milliseconds) { budgetMs_ = milliseconds; }
+    bool isRendering() const { return running_; }
+
+    // Root fiber of the last committed tree
+    const FiberNode::Ptr& committed() const { return committed_; }
+
 private:
+    // Start the next scheduled update, if any
+    bool startNext();
+    void commitRoot();
+
     std::shared_ptr<UpdateScheduler> scheduler_;
+    Reconciler reconciler_;
+    Clock clock_;
+    CommitHandler commit_;
+    FiberNode::Ptr workRoot_;   // Tree being built
+    FiberNode::Ptr committed_;
     bool running_;
     uint64_t frameStartTime_;
+    uint64_t budgetMs_;
     static constexpr uint64_t FRAME_BUDGET_MS = 16; // ~60 FPS
 };
 
 } // namespace reactpp
-
@@ -9,5 +9,21 @@ Component::Component()
       displayName_("Component") {
 }
 
+Component::~Component() {
+    for (EventHandle handle : handlers_) {
+        HandlerTable::global().release(handle);
+    }
+}
+
+EventHandle Component::addHandler(HandlerTable::ClickHandler handler) {
+    handlers_.push_back(HandlerTable::global().add(std::move(handler)));
+    return handlers_.back();
+}
+
+EventHandle Component::addHandler(HandlerTable::ChangeHandler handler) {
+    handlers_.push_back(HandlerTable::global().add(std::move(handler)));
+    return handlers_.back();
+}
+
 } // namespace reactpp
 
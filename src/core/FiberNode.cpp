@@ -1,28 +1,51 @@
 #include "reactpp/core/FiberNode.hpp"
+#include "reactpp/core/FiberPool.hpp"
+#include <memory_resource>
+#include <utility>
 
 namespace reactpp {
 
 FiberNode::FiberNode()
     : type(VNodeType::Element),
+      return_(nullptr),
       effectTag(EffectTag::None),
-      priority(Priority::Normal) {
+      priority(Priority::Normal),
+      hasComponents(false) {
 }
 
 FiberNode::Ptr FiberNode::create(VNode::Ptr vnode) {
-    auto fiber = std::make_shared<FiberNode>();
-    fiber->vnode = vnode;
+    auto fiber = std::allocate_shared<FiberNode>(
+        std::pmr::polymorphic_allocator<FiberNode>(&FiberPool::global()));
+    fiber->reset(std::move(vnode));
+    return fiber;
+}
+
+void FiberNode::reset(VNode::Ptr node) {
+    vnode = std::move(node);
     if (vnode) {
-        fiber->type = vnode->getType();
-        fiber->memoizedProps = vnode->getProps();
-        fiber->pendingProps = vnode->getProps();
+        type = vnode->getType();
+        // Shares the node's props storage; read through const so frozen
+        // nodes are accepted and the node's cached hash is kept
+        memoizedProps = std::as_const(*vnode).getProps();
+        pendingProps = memoizedProps;
+    } else {
+        type = VNodeType::Element;
+        memoizedProps = Props();
+        pendingProps = Props();
     }
-    return fiber;
+    return_ = nullptr;
+    child.reset();
+    sibling.reset();
+    alternate.reset();
+    effectTag = EffectTag::None;
+    hasComponents = false;
+    effectList.clear();  // Keeps its capacity for the next render
 }
 
 void FiberNode::appendChild(Ptr child) {
     if (!child) return;
     
-    child->return_ = shared_from_this();
+    child->return_ = this;
     
     if (!this->child) {
         this->child = child;
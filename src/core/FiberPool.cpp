@@ -0,0 +1,77 @@
+#include "reactpp/core/FiberPool.hpp"
+#include <cstddef>
+#include <new>
+
+namespace reactpp {
+
+FiberPool& FiberPool::global() {
+    static FiberPool* pool = new FiberPool();
+    return *pool;
+}
+
+FiberPool::~FiberPool() {
+    trim();
+}
+
+size_t FiberPool::allocated() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return allocated_;
+}
+
+size_t FiberPool::available() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return available_;
+}
+
+void FiberPool::trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (free_) {
+        FreeBlock* block = free_;
+        free_ = block->next;
+        ::operator delete(static_cast<void*>(block));
+    }
+    available_ = 0;
+}
+
+bool FiberPool::pooled(size_t bytes, size_t alignment) const {
+    return bytes == blockSize_ && alignment <= alignof(std::max_align_t);
+}
+
+void* FiberPool::do_allocate(size_t bytes, size_t alignment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (blockSize_ == 0 && bytes >= sizeof(FreeBlock) && alignment <= alignof(std::max_align_t)) {
+            blockSize_ = bytes;
+        }
+        if (pooled(bytes, alignment)) {
+            if (FreeBlock* block = free_) {
+                free_ = block->next;
+                --available_;
+                return block;
+            }
+            ++allocated_;
+            return ::operator new(blockSize_);
+        }
+    }
+    return std::pmr::get_default_resource()->allocate(bytes, alignment);
+}
+
+void FiberPool::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pooled(bytes, alignment)) {
+            auto* block = static_cast<FreeBlock*>(p);
+            block->next = free_;
+            free_ = block;
+            ++available_;
+            return;
+        }
+    }
+    std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+}
+
+bool FiberPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace reactpp
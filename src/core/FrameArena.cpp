@@ -0,0 +1,159 @@
+#include "reactpp/core/FrameArena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace reactpp {
+
+namespace {
+thread_local FrameArena* currentArena = nullptr;
+}
+
+FrameArena::FrameArena(size_t blockSize)
+    : blockSize_(blockSize), active_(0) {
+}
+
+FrameArena::~FrameArena() {
+    // Destructors cannot throw; freeing the blocks would leave the live
+    // allocations dangling, so stop here instead
+    if (liveAllocations() != 0) {
+        std::fprintf(stderr, "FrameArena: destroyed while %zu allocations are still alive\n",
+                     liveAllocations());
+        std::abort();
+    }
+    freeBlocks(pools_[0]);
+    freeBlocks(pools_[1]);
+}
+
+void FrameArena::beginFrame() {
+    int next = 1 - active_;
+    if (pools_[next].live != 0) {
+        throw std::runtime_error(
+            "FrameArena: " + std::to_string(pools_[next].live) +
+            " allocations from two frames ago are still alive");
+    }
+    rewind(pools_[next]);
+    active_ = next;
+}
+
+void FrameArena::reset() {
+    if (pools_[0].live != 0 || pools_[1].live != 0) {
+        throw std::runtime_error("FrameArena: cannot reset while allocations are alive");
+    }
+    rewind(pools_[0]);
+    rewind(pools_[1]);
+}
+
+size_t FrameArena::bytesUsed() const {
+    return pools_[0].used + pools_[1].used;
+}
+
+size_t FrameArena::bytesReserved() const {
+    size_t total = 0;
+    for (const auto& pool : pools_) {
+        for (const auto& block : pool.blocks) {
+            total += block.size;
+        }
+    }
+    return total;
+}
+
+size_t FrameArena::liveAllocations() const {
+    return pools_[0].live + pools_[1].live;
+}
+
+FrameArena::Scope::Scope(FrameArena& arena)
+    : previous_(currentArena) {
+    currentArena = &arena;
+}
+
+FrameArena::Scope::~Scope() {
+    currentArena = previous_;
+}
+
+FrameArena::Suspend::Suspend()
+    : previous_(currentArena) {
+    currentArena = nullptr;
+}
+
+FrameArena::Suspend::~Suspend() {
+    currentArena = previous_;
+}
+
+FrameArena* FrameArena::current() {
+    return currentArena;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    Pool& pool = pools_[active_];
+
+    while (pool.blockIndex < pool.blocks.size()) {
+        Block& block = pool.blocks[pool.blockIndex];
+        size_t aligned = (pool.offset + alignment - 1) & ~(alignment - 1);
+        if (aligned + bytes <= block.size) {
+            pool.offset = aligned + bytes;
+            pool.used += bytes;
+            ++pool.live;
+            return block.data + aligned;
+        }
+        ++pool.blockIndex;
+        pool.offset = 0;
+    }
+
+    // Out of blocks: add one big enough for this request
+    size_t size = std::max(blockSize_, bytes + alignment);
+    Block block{static_cast<char*>(::operator new(size)), size};
+    pool.blocks.push_back(block);
+    pool.blockIndex = pool.blocks.size() - 1;
+
+    size_t aligned = (reinterpret_cast<uintptr_t>(block.data) + alignment - 1) & ~(alignment - 1);
+    pool.offset = aligned - reinterpret_cast<uintptr_t>(block.data) + bytes;
+    pool.used += bytes;
+    ++pool.live;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void FrameArena::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    (void)bytes;
+    (void)alignment;
+    // Memory is reclaimed per frame; only track that the allocation is dead
+    if (Pool* pool = owningPool(p)) {
+        --pool->live;
+    }
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void FrameArena::rewind(Pool& pool) {
+    pool.blockIndex = 0;
+    pool.offset = 0;
+    pool.used = 0;
+}
+
+void FrameArena::freeBlocks(Pool& pool) {
+    for (auto& block : pool.blocks) {
+        ::operator delete(block.data);
+    }
+    pool.blocks.clear();
+    rewind(pool);
+}
+
+FrameArena::Pool* FrameArena::owningPool(const void* p) {
+    const char* address = static_cast<const char*>(p);
+    for (auto& pool : pools_) {
+        for (const auto& block : pool.blocks) {
+            if (address >= block.data && address < block.data + block.size) {
+                return &pool;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace reactpp
@@ -0,0 +1,135 @@
+#include "reactpp/core/HandlerTable.hpp"
+
+namespace reactpp {
+
+HandlerTable& HandlerTable::global() {
+    static HandlerTable table;
+    return table;
+}
+
+EventHandle HandlerTable::add(ClickHandler handler) {
+    return insert(Handler(std::move(handler)));
+}
+
+EventHandle HandlerTable::add(ChangeHandler handler) {
+    return insert(Handler(std::move(handler)));
+}
+
+bool HandlerTable::replace(EventHandle handle, ClickHandler handler) {
+    return assign(handle, Handler(std::move(handler)));
+}
+
+bool HandlerTable::replace(EventHandle handle, ChangeHandler handler) {
+    return assign(handle, Handler(std::move(handler)));
+}
+
+void HandlerTable::release(EventHandle handle) {
+    Slot* slot = find(handle);
+    if (!slot) {
+        return;
+    }
+    ++slot->generation;
+    --live_;
+    if (dispatchDepth_ > 0) {
+        pendingFree_.push_back(handle.slot - 1);
+    } else {
+        slot->handler = std::monostate();
+        freeSlots_.push_back(handle.slot - 1);
+    }
+}
+
+bool HandlerTable::contains(EventHandle handle) const {
+    return find(handle) != nullptr;
+}
+
+bool HandlerTable::invoke(EventHandle handle) {
+    Slot* slot = find(handle);
+    auto* fn = slot ? std::get_if<ClickHandler>(&slot->handler) : nullptr;
+    if (!fn || !*fn) {
+        return false;
+    }
+    ++dispatchDepth_;
+    try {
+        (*fn)();
+    } catch (...) {
+        finishDispatch();
+        throw;
+    }
+    finishDispatch();
+    return true;
+}
+
+bool HandlerTable::invoke(EventHandle handle, const std::string& value) {
+    Slot* slot = find(handle);
+    auto* fn = slot ? std::get_if<ChangeHandler>(&slot->handler) : nullptr;
+    if (!fn || !*fn) {
+        return false;
+    }
+    ++dispatchDepth_;
+    try {
+        (*fn)(value);
+    } catch (...) {
+        finishDispatch();
+        throw;
+    }
+    finishDispatch();
+    return true;
+}
+
+HandlerTable::Slot* HandlerTable::find(EventHandle handle) {
+    return const_cast<Slot*>(static_cast<const HandlerTable*>(this)->find(handle));
+}
+
+const HandlerTable::Slot* HandlerTable::find(EventHandle handle) const {
+    if (handle.slot == 0 || handle.slot > slots_.size()) {
+        return nullptr;
+    }
+    const Slot& slot = slots_[handle.slot - 1];
+    return slot.generation == handle.generation ? &slot : nullptr;
+}
+
+EventHandle HandlerTable::insert(Handler handler) {
+    uint32_t index;
+    if (!freeSlots_.empty()) {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    Slot& slot = slots_[index];
+    slot.handler = std::move(handler);
+    ++live_;
+    return EventHandle{index + 1, slot.generation};
+}
+
+bool HandlerTable::assign(EventHandle handle, Handler handler) {
+    Slot* slot = find(handle);
+    if (!slot) {
+        return false;
+    }
+    if (dispatchDepth_ > 0) {
+        // The current function may be the one running
+        pendingReplace_.emplace_back(handle.slot - 1, std::move(handler));
+        return true;
+    }
+    slot->handler = std::move(handler);
+    return true;
+}
+
+void HandlerTable::finishDispatch() {
+    if (--dispatchDepth_ > 0) {
+        return;
+    }
+    for (auto& [index, handler] : pendingReplace_) {
+        slots_[index].handler = std::move(handler);
+    }
+    pendingReplace_.clear();
+    for (uint32_t index : pendingFree_) {
+        slots_[index].handler = std::monostate();
+        freeSlots_.push_back(index);
+    }
+    pendingFree_.clear();
+}
+
+} // namespace reactpp
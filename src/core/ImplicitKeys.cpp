@@ -0,0 +1,29 @@
+#include "reactpp/core/ImplicitKeys.hpp"
+#include "reactpp/core/Hash.hpp"
+#include <atomic>
+
+namespace reactpp {
+
+namespace {
+// Global rather than per thread so trees built on worker threads are keyed too
+std::atomic<bool> implicitKeysEnabled{false};
+}
+
+void ImplicitKeys::setEnabled(bool enabled) {
+    implicitKeysEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool ImplicitKeys::enabled() {
+    return implicitKeysEnabled.load(std::memory_order_relaxed);
+}
+
+uint64_t ImplicitKeys::forSite(const CallSite& site) {
+    if (!enabled()) {
+        return 0;
+    }
+    uint64_t key = hashCombine(reinterpret_cast<uintptr_t>(site.file), site.line);
+    key = hashMix(hashCombine(key, site.column));
+    return key == 0 ? 1 : key;  // 0 means no key
+}
+
+} // namespace reactpp
@@ -0,0 +1,53 @@
+#include "reactpp/core/InternTable.hpp"
+#include <mutex>
+
+namespace reactpp {
+
+InternTable::InternTable(std::initializer_list<const char*> predefined) {
+    for (const char* name : predefined) {
+        intern(name);
+    }
+}
+
+uint32_t InternTable::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    
+    names_.emplace_back(name);
+    uint32_t id = static_cast<uint32_t>(names_.size());
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+uint32_t InternTable::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : InvalidId;
+}
+
+const std::string& InternTable::name(uint32_t id) const {
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id == InvalidId || id > names_.size()) {
+        return empty;
+    }
+    return names_[id - 1];
+}
+
+size_t InternTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+} // namespace reactpp
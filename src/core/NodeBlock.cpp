@@ -0,0 +1,73 @@
+#include "reactpp/core/NodeBlock.hpp"
+#include <cstdint>
+#include <new>
+
+namespace reactpp {
+
+namespace {
+thread_local NodeBlock* currentBlock = nullptr;
+
+constexpr size_t HeaderSize =
+    (sizeof(NodeBlock) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+}
+
+NodeBlock* NodeBlock::create(size_t capacity) {
+    void* memory = ::operator new(HeaderSize + capacity);
+    return new (memory) NodeBlock(capacity);
+}
+
+NodeBlock::NodeBlock(size_t capacity)
+    : data_(reinterpret_cast<char*>(this) + HeaderSize), capacity_(capacity) {
+}
+
+void NodeBlock::release() {
+    unref();
+}
+
+void NodeBlock::unref() {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        this->~NodeBlock();
+        ::operator delete(static_cast<void*>(this));
+    }
+}
+
+NodeBlock::Scope::Scope(NodeBlock& block)
+    : previous_(currentBlock) {
+    currentBlock = &block;
+}
+
+NodeBlock::Scope::~Scope() {
+    currentBlock = previous_;
+}
+
+NodeBlock* NodeBlock::current() {
+    return currentBlock;
+}
+
+void* NodeBlock::do_allocate(size_t bytes, size_t alignment) {
+    size_t aligned = (offset_ + alignment - 1) & ~(alignment - 1);
+    requested_ += aligned - offset_ + bytes;
+    // Every allocation holds the block, which its deallocation goes through
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    if (aligned + bytes > capacity_) {
+        offset_ = capacity_;
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+    offset_ = aligned + bytes;
+    return data_ + aligned;
+}
+
+void NodeBlock::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    const char* address = static_cast<const char*>(p);
+    if (address < data_ || address >= data_ + capacity_) {
+        std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+    // Block memory is reclaimed with the whole block
+    unref();
+}
+
+bool NodeBlock::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace reactpp
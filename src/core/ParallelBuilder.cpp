@@ -0,0 +1,109 @@
+#include "reactpp/core/ParallelBuilder.hpp"
+#include <algorithm>
+
+namespace reactpp {
+
+ParallelBuilder::ParallelBuilder(size_t threadCount, bool useArenas)
+    : generation_(0), running_(0), stopping_(false),
+      job_(nullptr), jobCount_(0), nextIndex_(0), results_(nullptr) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    if (useArenas) {
+        for (size_t i = 0; i < threadCount; ++i) {
+            arenas_.push_back(std::make_unique<FrameArena>());
+        }
+    }
+    
+    for (size_t worker = 1; worker < threadCount; ++worker) {
+        threads_.emplace_back(&ParallelBuilder::workerLoop, this, worker);
+    }
+}
+
+ParallelBuilder::~ParallelBuilder() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ParallelBuilder::beginFrame() {
+    for (auto& arena : arenas_) {
+        arena->beginFrame();
+    }
+}
+
+std::vector<VNode::Ptr> ParallelBuilder::build(size_t count, const BuildFn& build) {
+    std::vector<VNode::Ptr> results(count);
+    if (count == 0) return results;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &build;
+        jobCount_ = count;
+        nextIndex_.store(0, std::memory_order_relaxed);
+        results_ = &results;
+        error_ = nullptr;
+        running_ = threads_.size();
+        ++generation_;
+    }
+    wake_.notify_all();
+    
+    // The calling thread works too
+    runJobs(0);
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return running_ == 0; });
+    job_ = nullptr;
+    results_ = nullptr;
+    
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    return results;
+}
+
+void ParallelBuilder::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+        }
+        
+        runJobs(worker);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --running_;
+        }
+        done_.notify_one();
+    }
+}
+
+void ParallelBuilder::runJobs(size_t worker) {
+    std::unique_ptr<FrameArena::Scope> scope;
+    if (!arenas_.empty()) {
+        scope = std::make_unique<FrameArena::Scope>(*arenas_[worker]);
+    }
+    
+    // Pull indices until the job is drained
+    size_t index;
+    while ((index = nextIndex_.fetch_add(1, std::memory_order_relaxed)) < jobCount_) {
+        try {
+            (*results_)[index] = (*job_)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+}
+
+} // namespace reactpp
@@ -0,0 +1,215 @@
+#include "reactpp/core/PropComparators.hpp"
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/renderer/RendererTypes.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace reactpp {
+
+namespace {
+
+struct TypeOps {
+    PropComparators::EqualFn equal;
+    PropComparators::HashFn hash;
+    bool handler = false;
+};
+
+template<typename T>
+TypeOps valueOps() {
+    return {
+        [](const std::any& a, const std::any& b) {
+            return *std::any_cast<T>(&a) == *std::any_cast<T>(&b);
+        },
+        [](const std::any& value) -> uint64_t {
+            return std::hash<T>{}(*std::any_cast<T>(&value));
+        }
+    };
+}
+
+// Handlers compare by identity: plain function pointers by address, anything
+// else only when it is the very same stored object
+template<typename Signature>
+TypeOps handlerOps() {
+    using Fn = std::function<Signature>;
+    using Ptr = std::add_pointer_t<Signature>;
+    return {
+        [](const std::any& a, const std::any& b) {
+            if (&a == &b) return true;
+            const Fn& fa = *std::any_cast<Fn>(&a);
+            const Fn& fb = *std::any_cast<Fn>(&b);
+            if (!fa || !fb) return !fa && !fb;
+            const Ptr* pa = fa.template target<Ptr>();
+            const Ptr* pb = fb.template target<Ptr>();
+            return pa && pb && *pa == *pb;
+        },
+        {},
+        true
+    };
+}
+
+// Handles are plain values: the same registration compares equal in every
+// render
+TypeOps eventHandleOps() {
+    return {
+        [](const std::any& a, const std::any& b) {
+            return *std::any_cast<EventHandle>(&a) == *std::any_cast<EventHandle>(&b);
+        },
+        [](const std::any& value) -> uint64_t {
+            const EventHandle& handle = *std::any_cast<EventHandle>(&value);
+            return (uint64_t{handle.slot} << 32) | handle.generation;
+        },
+        true
+    };
+}
+
+TypeOps gradientOps() {
+    using Stops = std::vector<renderer::GradientStop>;
+    return {
+        [](const std::any& a, const std::any& b) {
+            const Stops& sa = *std::any_cast<Stops>(&a);
+            const Stops& sb = *std::any_cast<Stops>(&b);
+            if (sa.size() != sb.size()) return false;
+            for (size_t i = 0; i < sa.size(); ++i) {
+                if (sa[i].position != sb[i].position || sa[i].color != sb[i].color) {
+                    return false;
+                }
+            }
+            return true;
+        },
+        [](const std::any& value) -> uint64_t {
+            uint64_t result = 0;
+            for (const auto& stop : *std::any_cast<Stops>(&value)) {
+                result = result * 31 + std::hash<float>{}(stop.position);
+                result = result * 31 + stop.color;
+            }
+            return result;
+        }
+    };
+}
+
+using OpsPtr = std::shared_ptr<const TypeOps>;
+
+// Registered ops are immutable once published: registering a type replaces
+// its pointer, so callers can hold ops and invoke them without the lock
+struct Registry {
+    std::shared_mutex mutex;
+    std::unordered_map<std::type_index, OpsPtr> ops;
+    std::atomic<uint64_t> version{0};  // Bumped by every change
+    
+    Registry() {
+        add(typeid(int), valueOps<int>());
+        add(typeid(uint32_t), valueOps<uint32_t>());
+        add(typeid(float), valueOps<float>());
+        add(typeid(double), valueOps<double>());
+        add(typeid(bool), valueOps<bool>());
+        add(typeid(std::string), valueOps<std::string>());
+        add(typeid(std::vector<renderer::GradientStop>), gradientOps());
+        add(typeid(std::function<void()>), handlerOps<void()>());
+        add(typeid(std::function<void(const std::string&)>), handlerOps<void(const std::string&)>());
+        add(typeid(EventHandle), eventHandleOps());
+    }
+    
+    void add(std::type_index type, TypeOps typeOps) {
+        ops.emplace(type, std::make_shared<const TypeOps>(std::move(typeOps)));
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Ops for type, or null if unregistered. Each thread caches lookups until
+// the registry changes, so the steady state takes no lock.
+OpsPtr lookup(std::type_index type) {
+    struct Cache {
+        uint64_t version = ~uint64_t(0);
+        std::unordered_map<std::type_index, OpsPtr> ops;
+    };
+    thread_local Cache cache;
+    
+    auto& reg = registry();
+    uint64_t version = reg.version.load(std::memory_order_acquire);
+    if (cache.version != version) {
+        cache.ops.clear();
+        cache.version = version;
+    }
+    auto cached = cache.ops.find(type);
+    if (cached != cache.ops.end()) {
+        return cached->second;
+    }
+    
+    OpsPtr ops;
+    {
+        std::shared_lock<std::shared_mutex> lock(reg.mutex);
+        auto it = reg.ops.find(type);
+        if (it != reg.ops.end()) {
+            ops = it->second;
+        }
+    }
+    cache.ops.emplace(type, ops);
+    return ops;
+}
+
+} // namespace
+
+void PropComparators::registerErased(std::type_index type, EqualFn equal, HashFn hash) {
+    auto& reg = registry();
+    OpsPtr previous;  // Released after the lock
+    std::unique_lock<std::shared_mutex> lock(reg.mutex);
+    auto& slot = reg.ops[type];
+    // Replacing the comparator of a handler type keeps it a handler
+    bool handler = slot && slot->handler;
+    previous = std::exchange(slot, std::make_shared<const TypeOps>(TypeOps{std::move(equal), std::move(hash), handler}));
+    reg.version.fetch_add(1, std::memory_order_release);
+}
+
+void PropComparators::unregisterType(std::type_index type) {
+    auto& reg = registry();
+    OpsPtr previous;
+    std::unique_lock<std::shared_mutex> lock(reg.mutex);
+    auto it = reg.ops.find(type);
+    if (it != reg.ops.end()) {
+        previous = std::move(it->second);
+        reg.ops.erase(it);
+        reg.version.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool PropComparators::isRegistered(std::type_index type) {
+    return lookup(type) != nullptr;
+}
+
+bool PropComparators::isHandler(std::type_index type) {
+    OpsPtr ops = lookup(type);
+    return ops && ops->handler;
+}
+
+bool PropComparators::isHashable(std::type_index type) {
+    OpsPtr ops = lookup(type);
+    return ops && ops->hash;
+}
+
+bool PropComparators::equal(std::type_index type, const std::any& a, const std::any& b) {
+    OpsPtr ops = lookup(type);
+    if (!ops) {
+        return &a == &b;
+    }
+    return ops->equal(a, b);
+}
+
+uint64_t PropComparators::hash(std::type_index type, const std::any& value) {
+    OpsPtr ops = lookup(type);
+    if (!ops || !ops->hash) {
+        return 0;
+    }
+    return ops->hash(value);
+}
+
+} // namespace reactpp
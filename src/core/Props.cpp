@@ -1,7 +1,147 @@
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/Hash.hpp"
+#include "reactpp/core/FrameArena.hpp"
+#include "reactpp/core/NodeBlock.hpp"
+#include <unordered_map>
 
 namespace reactpp {
 // Props implementation is mostly template-based, so most code is in the header
-// This file exists for potential future non-template implementations
+
+namespace {
+
+// Per-thread name -> key cache so string-keyed lookups skip the table lock.
+// Views point into the key table's storage, which is never freed.
+std::unordered_map<std::string_view, uint32_t>& keyCache() {
+    thread_local std::unordered_map<std::string_view, uint32_t> cache;
+    return cache;
+}
+
+} // namespace
+
+std::pmr::memory_resource* Props::resource() {
+    if (NodeBlock* block = NodeBlock::current()) {
+        return block;
+    }
+    if (FrameArena* arena = FrameArena::current()) {
+        return arena;
+    }
+    return std::pmr::get_default_resource();
+}
+
+InternTable& PropKey::table() {
+    // Order must match the ids in reactpp::keys
+    static InternTable table({
+        "x",
+        "y",
+        "width",
+        "height",
+        "backgroundColor",
+        "borderColor",
+        "color",
+        "fontSize",
+        "borderWidth",
+        "gradient",
+        "gradientDirection",
+        "onClick",
+        "onChange",
+        "value"
+    });
+    return table;
+}
+
+PropKey PropKey::intern(std::string_view name) {
+    auto& cache = keyCache();
+    auto it = cache.find(name);
+    if (it != cache.end()) {
+        return PropKey(it->second);
+    }
+    
+    uint32_t id = table().intern(name);
+    cache.emplace(table().name(id), id);
+    return PropKey(id);
+}
+
+PropKey PropKey::find(std::string_view name) {
+    auto& cache = keyCache();
+    auto it = cache.find(name);
+    if (it != cache.end()) {
+        return PropKey(it->second);
+    }
+    
+    uint32_t id = table().find(name);
+    if (id != InternTable::InvalidId) {
+        cache.emplace(table().name(id), id);
+    }
+    return PropKey(id);
 }
 
+uint64_t Props::hash() const {
+    return hashImpl(false);
+}
+
+bool Props::isFullyHashed() const {
+    for (const auto& entry : data().entries) {
+        if (!PropComparators::isHashable(entry.type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t Props::visualHash() const {
+    return hashImpl(true);
+}
+
+uint64_t Props::hashImpl(bool skipHandlers) const {
+    // Sum of per-entry hashes, so insertion order does not matter
+    uint64_t result = 0;
+    size_t count = 0;
+    for (uint8_t i = 0; i < BuiltinProps::FieldCount; ++i) {
+        auto field = static_cast<BuiltinProps::Field>(i);
+        if (data().builtins.has(field)) {
+            result += hashMix(hashCombine(BuiltinProps::keyOf(field).id(), data().builtins.raw(field)));
+            ++count;
+        }
+    }
+    for (const auto& entry : data().entries) {
+        if (skipHandlers && PropComparators::isHandler(entry.type)) {
+            continue;
+        }
+        uint64_t entryHash = hashCombine(entry.key.id(), entry.type.hash_code());
+        entryHash = hashCombine(entryHash, PropComparators::hash(entry.type, entry.value));
+        result += hashMix(entryHash);
+        ++count;
+    }
+    return result + hashMix(count);
+}
+
+bool Props::visuallyEquals(const Props& other) const {
+    if (sharesStorageWith(other)) {
+        return true;
+    }
+    if (data().builtins != other.data().builtins) {
+        return false;
+    }
+    
+    size_t count = 0;
+    for (const auto& entry : data().entries) {
+        if (PropComparators::isHandler(entry.type)) {
+            continue;
+        }
+        const Entry* otherEntry = other.findEntry(entry.key);
+        if (!otherEntry || otherEntry->type != entry.type ||
+            !PropComparators::equal(entry.type, entry.value, otherEntry->value)) {
+            return false;
+        }
+        ++count;
+    }
+    size_t otherCount = 0;
+    for (const auto& entry : other.data().entries) {
+        if (!PropComparators::isHandler(entry.type)) {
+            ++otherCount;
+        }
+    }
+    return count == otherCount;
+}
+
+}
@@ -1,15 +1,445 @@
 #include "reactpp/core/Reconciler.hpp"
+#include "reactpp/core/Hash.hpp"
+#include "reactpp/hooks/HookManager.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 namespace reactpp {
 
+namespace {
+
+// Type, tag and (for components) component class must agree to reuse a node
+bool sameType(const VNode& a, const VNode& b) {
+    if (a.getType() != b.getType() || a.getTagId() != b.getTagId()) {
+        return false;
+    }
+    if (a.getType() == VNodeType::Component) {
+        auto first = a.getComponent();
+        auto second = b.getComponent();
+        return first && second ? typeid(*first) == typeid(*second) : first == second;
+    }
+    return true;
+}
+
+// The node itself differs, ignoring children
+bool ownChanged(const VNode& a, const VNode& b) {
+    return a.getText() != b.getText() || a.getProps() != b.getProps() ||
+           a.getComponent() != b.getComponent();
+}
+
+// Matching slot of a child: its key, implicit key or position among unkeyed
+// siblings, hashed into separate domains as in VNode::deriveStableId.
+// Advances unkeyed for unkeyed nodes.
+uint64_t matchSlot(const VNode& node, size_t& unkeyed) {
+    if (const auto& key = node.getKey()) {
+        return hashCombine(1, std::hash<std::string>{}(*key));
+    }
+    if (uint64_t implicit = node.getImplicitKey()) {
+        return hashCombine(3, implicit);
+    }
+    return hashCombine(2, unkeyed++);
+}
+
+// Rules out slot hash collisions between explicit keys
+bool sameSlot(const VNode& a, const VNode& b) {
+    return a.getKey() == b.getKey() && (a.getKey() || a.getImplicitKey() == b.getImplicitKey());
+}
+
+// Marks a longest strictly increasing subsequence of sources in keep,
+// skipping negative entries. O(n log n): tails[k] is the entry ending the
+// smallest-tailed run of length k + 1 found so far.
+void longestIncreasingSubsequence(const std::vector<int32_t>& sources, std::vector<size_t>& tails,
+                                  std::vector<size_t>& previous, std::vector<char>& keep) {
+    constexpr size_t None = std::numeric_limits<size_t>::max();
+    tails.clear();
+    previous.assign(sources.size(), None);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (sources[i] < 0) continue;
+        auto it = std::lower_bound(tails.begin(), tails.end(), sources[i],
+                                   [&](size_t tail, int32_t value) { return sources[tail] < value; });
+        if (it != tails.begin()) {
+            previous[i] = *(it - 1);
+        }
+        if (it == tails.end()) {
+            tails.push_back(i);
+        } else {
+            *it = i;
+        }
+    }
+
+    keep.assign(sources.size(), 0);
+    for (size_t i = tails.empty() ? None : tails.back(); i != None; i = previous[i]) {
+        keep[i] = 1;
+    }
+}
+
+// Sets a component's props for the lifetime of the scope
+class PropsOverride {
+public:
+    PropsOverride(Component& component, const Props& props)
+        : component_(component), saved_(component.getProps()) {
+        component_.setProps(props);
+    }
+    ~PropsOverride() {
+        component_.setProps(saved_);
+    }
+
+    PropsOverride(const PropsOverride&) = delete;
+    PropsOverride& operator=(const PropsOverride&) = delete;
+
+private:
+    Component& component_;
+    Props saved_;
+};
+
+bool dirty(const Component& component) {
+    auto hooks = component.getHookManager();
+    return hooks && hooks->isDirty();
+}
+
+// A component in the fiber's subtree has pending state. Only branches
+// flagged hasComponents are walked.
+bool dirtyBelow(const FiberNode& fiber) {
+    if (!fiber.hasComponents) {
+        return false;
+    }
+    for (const FiberNode* child = fiber.child.get(); child; child = child->sibling.get()) {
+        if ((child->component && dirty(*child->component)) || dirtyBelow(*child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Flag fiber and its ancestors as having components below. Stops at the
+// first flagged one: its ancestors are already flagged.
+void markComponentPath(FiberNode* fiber) {
+    for (; fiber && !fiber->hasComponents; fiber = fiber->return_) {
+        fiber->hasComponents = true;
+    }
+}
+
+} // namespace
+
 Reconciler::Reconciler() = default;
 
 Reconciler::~Reconciler() = default;
 
+FiberNode::Ptr Reconciler::reconcile(const FiberNode::Ptr& current, VNode::Ptr next) {
+    FiberNode::Ptr root = begin(current, std::move(next));
+    while (performUnitOfWork()) {
+    }
+    commit();
+    return root;
+}
+
 FiberNode::Ptr Reconciler::reconcile(VNode::Ptr current, VNode::Ptr next) {
-    // Reconciliation logic - to be implemented
-    return nullptr;
+    return reconcile(current ? FiberNode::create(std::move(current)) : FiberNode::Ptr(), std::move(next));
 }
 
-} // namespace reactpp
+FiberNode::Ptr Reconciler::begin(VNode::Ptr current, VNode::Ptr next) {
+    return begin(current ? FiberNode::create(std::move(current)) : FiberNode::Ptr(), std::move(next));
+}
+
+FiberNode::Ptr Reconciler::begin(const FiberNode::Ptr& current, VNode::Ptr next) {
+    stats_ = Stats();
+    root_.reset();
+    next_ = nullptr;
+    rendered_.clear();
+    shared_.clear();
+    if (current && !current->vnode) {
+        return begin(FiberNode::Ptr(), std::move(next));
+    }
+    if (!next) {
+        if (!current) {
+            return nullptr;
+        }
+        auto deletion = FiberNode::create(current->vnode);
+        deletion->alternate = current;
+        deletion->markForUpdate(EffectTag::Deletion);
+        ++stats_.deletions;
+        return deletion;
+    }
 
+    FiberNode::Ptr root;
+    if (current && sameType(*current->vnode, *next)) {
+        root = workInProgress(*current, next, nullptr);
+        if (ownChanged(*current->vnode, *next)) {
+            root->addEffect(EffectTag::Update);
+            ++stats_.updates;
+        }
+    } else {
+        root = createFiber(next, nullptr);
+        root->markForUpdate(EffectTag::Placement);
+        ++stats_.placements;
+        if (current) {
+            auto deletion = FiberNode::create(current->vnode);
+            deletion->alternate = current;
+            deletion->markForUpdate(EffectTag::Deletion);
+            root->addToEffectList(deletion);
+            ++stats_.deletions;
+        }
+    }
+    root_ = root;
+    next_ = root.get();
+    return root;
+}
+
+bool Reconciler::performUnitOfWork() {
+    if (!next_) {
+        return false;
+    }
+    FiberNode* fiber = next_;
+    bool descend = beginWork(*fiber, *root_);
+
+    // Depth-first: child, else sibling, else back up through return_ to the
+    // nearest ancestor with a sibling
+    if (descend && fiber->child) {
+        next_ = fiber->child.get();
+        return true;
+    }
+    while (fiber != root_.get() && !fiber->sibling) {
+        fiber = fiber->return_;
+    }
+    next_ = fiber == root_.get() ? nullptr : fiber->sibling.get();
+    if (!next_) {
+        root_.reset();
+        return false;
+    }
+    return true;
+}
+
+bool Reconciler::beginWork(FiberNode& fiber, FiberNode& root) {
+    FiberNode* current = fiber.alternate && fiber.alternate->vnode ? fiber.alternate.get() : nullptr;
+    if (fiber.type == VNodeType::Component && fiber.vnode->getComponent()) {
+        return updateComponent(fiber, current, root);
+    }
+    // Subtrees with components are walked so each component's propsEqual
+    // decides
+    if (current && !current->hasComponents && current->vnode->isSameSubtree(*fiber.vnode)) {
+        bailout(fiber, *current);
+        ++stats_.skipped;
+        return false;
+    }
+    const auto& children = std::as_const(*fiber.vnode).getChildren();
+    reconcileChildren(fiber, current, children.data(), children.size(), root);
+    return true;
+}
+
+bool Reconciler::updateComponent(FiberNode& fiber, FiberNode* current, FiberNode& root) {
+    auto component = fiber.vnode->getComponent();
+    markComponentPath(fiber.return_);
+    const Props& props = std::as_const(*fiber.vnode).getProps();
+    // current->component is only set once current has rendered
+    if (current && current->component == component && !dirty(*component) &&
+        component->propsEqual(std::as_const(*current->vnode).getProps(), props) &&
+        !dirtyBelow(*current)) {
+        bailout(fiber, *current);
+        ++stats_.bailouts;
+        return false;
+    }
+
+    auto hooks = component->getHookManager();
+    if (hooks) {
+        hooks->reset();
+    }
+    rendered_.push_back({component, props, hooks ? hooks->markCount() : 0});
+    VNode::Ptr rendered;
+    {
+        // render() reads the new props; the instance keeps its committed
+        // ones until commit()
+        PropsOverride renderProps(*component, props);
+        rendered = component->render();
+    }
+    fiber.component = std::move(component);
+    ++stats_.renders;
+    reconcileChildren(fiber, current, &rendered, 1, root);
+    return true;
+}
+
+void Reconciler::commit() {
+    for (auto& update : rendered_) {
+        update.component->setProps(update.props);
+        if (auto hooks = update.component->getHookManager()) {
+            hooks->clearDirty(update.marks);
+        }
+    }
+    rendered_.clear();
+    
+    // Shared children move to the tree being committed. Done here, not in
+    // bailout(), so a dropped render leaves them pointing into the
+    // committed tree.
+    for (const auto& fiber : shared_) {
+        for (FiberNode* child = fiber->child.get(); child; child = child->sibling.get()) {
+            child->return_ = fiber.get();
+        }
+    }
+    shared_.clear();
+}
+
+void Reconciler::bailout(FiberNode& fiber, FiberNode& current) {
+    // Shared with the current tree rather than walked; re-parented by commit()
+    fiber.child = current.child;
+    if (fiber.child) {
+        shared_.push_back(fiber.shared_from_this());
+    }
+    if (current.hasComponents) {
+        markComponentPath(&fiber);
+    }
+}
+
+void Reconciler::reconcileChildren(FiberNode& fiber, FiberNode* current,
+                                   const VNode::Ptr* children, size_t count, FiberNode& root) {
+    if (!current) {
+        // A new subtree is mounted with its placed ancestor: no tags below it
+        FiberNode* last = nullptr;
+        for (const VNode::Ptr* child = children; child != children + count; ++child) {
+            if (!*child) continue;
+            auto childFiber = createFiber(*child, &fiber);
+            FiberNode* raw = childFiber.get();
+            (last ? last->sibling : fiber.child) = std::move(childFiber);
+            last = raw;
+        }
+        return;
+    }
+
+    // Current child fibers, or fibers for the current node's children if it
+    // was never expanded (it came from a VNode). A component's children are
+    // its render output, which an unexpanded node does not have.
+    oldFibers_.clear();
+    if (current->child) {
+        for (FiberNode* old = current->child.get(); old; old = old->sibling.get()) {
+            oldFibers_.push_back(old->shared_from_this());
+        }
+    } else if (current->vnode->getType() != VNodeType::Component) {
+        for (const auto& child : std::as_const(*current->vnode).getChildren()) {
+            if (child) {
+                oldFibers_.push_back(FiberNode::create(child));
+            }
+        }
+    }
+
+    oldSlots_.clear();
+    size_t unkeyed = 0;
+    for (size_t i = 0; i < oldFibers_.size(); ++i) {
+        oldSlots_.emplace_back(matchSlot(*oldFibers_[i]->vnode, unkeyed), static_cast<uint32_t>(i));
+    }
+
+    // Old position of each new child, or -1 if it is new. Children that keep
+    // their slot at the same position match without a lookup; after the
+    // first that doesn't, the old slots are sorted and searched.
+    matched_.assign(oldFibers_.size(), 0);
+    sources_.clear();
+    newFibers_.clear();
+    bool sorted = false;
+    FiberNode* last = nullptr;
+    unkeyed = 0;
+    for (const VNode::Ptr* entry = children; entry != children + count; ++entry) {
+        const VNode::Ptr& child = *entry;
+        if (!child) continue;
+        uint64_t slot = matchSlot(*child, unkeyed);
+        size_t position = newFibers_.size();
+        int32_t source = -1;
+        if (!sorted && position < oldSlots_.size() && oldSlots_[position].first == slot) {
+            source = static_cast<int32_t>(position);
+        } else {
+            if (!sorted) {
+                std::sort(oldSlots_.begin(), oldSlots_.end());
+                sorted = true;
+            }
+            auto it = std::lower_bound(oldSlots_.begin(), oldSlots_.end(), std::make_pair(slot, uint32_t(0)));
+            for (; it != oldSlots_.end() && it->first == slot; ++it) {
+                if (!matched_[it->second]) {
+                    source = static_cast<int32_t>(it->second);
+                    break;
+                }
+            }
+        }
+        if (source >= 0) {
+            const VNode& old = *oldFibers_[source]->vnode;
+            if (matched_[source] || !sameSlot(old, *child) || !sameType(old, *child)) {
+                source = -1;
+            }
+        }
+
+        FiberNode::Ptr childFiber;
+        if (source >= 0) {
+            matched_[source] = 1;
+            FiberNode& old = *oldFibers_[source];
+            childFiber = workInProgress(old, child, &fiber);
+            if (ownChanged(*old.vnode, *child)) {
+                childFiber->addEffect(EffectTag::Update);
+                ++stats_.updates;
+            }
+        } else {
+            childFiber = createFiber(child, &fiber);
+        }
+        sources_.push_back(source);
+        newFibers_.push_back(childFiber.get());
+        FiberNode* raw = childFiber.get();
+        (last ? last->sibling : fiber.child) = std::move(childFiber);
+        last = raw;
+    }
+
+    for (size_t i = 0; i < oldFibers_.size(); ++i) {
+        if (!matched_[i]) {
+            auto deletion = FiberNode::create(oldFibers_[i]->vnode);
+            deletion->alternate = oldFibers_[i];
+            deletion->return_ = &fiber;
+            deletion->markForUpdate(EffectTag::Deletion);
+            root.addToEffectList(deletion);
+            ++stats_.deletions;
+        }
+    }
+    oldFibers_.clear();
+
+    // Children on the longest increasing run of old positions keep their
+    // place; every other one is placed (moved or inserted) around them
+    longestIncreasingSubsequence(sources_, tails_, previous_, stay_);
+    for (size_t j = 0; j < newFibers_.size(); ++j) {
+        if (!stay_[j]) {
+            newFibers_[j]->addEffect(EffectTag::Placement);
+            ++stats_.placements;
+            if (sources_[j] >= 0) {
+                ++stats_.moves;
+            }
+        }
+        if (newFibers_[j]->effectTag != EffectTag::None) {
+            root.addToEffectList(newFibers_[j]->shared_from_this());
+        }
+    }
+}
+
+FiberNode::Ptr Reconciler::createFiber(const VNode::Ptr& node, FiberNode* parent) {
+    auto fiber = FiberNode::create(node);
+    fiber->return_ = parent;
+    ++stats_.fibers;
+    return fiber;
+}
+
+FiberNode::Ptr Reconciler::workInProgress(FiberNode& current, const VNode::Ptr& node, FiberNode* parent) {
+    // Taking the alternate leaves current without one: only the newer fiber
+    // of a pair points at the older
+    FiberNode::Ptr fiber = std::move(current.alternate);
+    if (fiber) {
+        fiber->reset(node);
+        ++stats_.reused;
+    } else {
+        fiber = FiberNode::create(node);
+    }
+    fiber->return_ = parent;
+    fiber->alternate = current.shared_from_this();
+    fiber->stateNode = current.stateNode;
+    fiber->memoizedState = current.memoizedState;
+    fiber->component = current.component;
+    ++stats_.fibers;
+    return fiber;
+}
+
+} // namespace reactpp
@@ -0,0 +1,58 @@
+#include "reactpp/core/TagId.hpp"
+#include <unordered_map>
+
+namespace reactpp {
+
+namespace {
+
+// Per-thread name -> tag cache so factories skip the table lock.
+// Views point into the tag table's storage, which is never freed.
+std::unordered_map<std::string_view, uint32_t>& tagCache() {
+    thread_local std::unordered_map<std::string_view, uint32_t> cache;
+    return cache;
+}
+
+} // namespace
+
+InternTable& TagId::table() {
+    // Order must match the ids in reactpp::tags
+    static InternTable table({
+        "View",
+        "Button",
+        "Text",
+        "Input"
+    });
+    return table;
+}
+
+TagId TagId::intern(std::string_view name) {
+    if (name.empty()) {
+        return TagId();
+    }
+    
+    auto& cache = tagCache();
+    auto it = cache.find(name);
+    if (it != cache.end()) {
+        return TagId(it->second);
+    }
+    
+    uint32_t id = table().intern(name);
+    cache.emplace(table().name(id), id);
+    return TagId(id);
+}
+
+TagId TagId::find(std::string_view name) {
+    auto& cache = tagCache();
+    auto it = cache.find(name);
+    if (it != cache.end()) {
+        return TagId(it->second);
+    }
+    
+    uint32_t id = table().find(name);
+    if (id != InternTable::InvalidId) {
+        cache.emplace(table().name(id), id);
+    }
+    return TagId(id);
+}
+
+} // namespace reactpp
@@ -1,105 +1,257 @@
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Component.hpp"
+#include "reactpp/core/FrameArena.hpp"
+#include "reactpp/core/Hash.hpp"
+#include "reactpp/core/NodeBlock.hpp"
 #include <sstream>
-#include <queue>
 #include <algorithm>
+#include <unordered_map>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
 
 namespace reactpp {
 
 std::atomic<uint64_t> VNode::next_id_{1};
 
-VNode::VNode(VNodeType type) 
-    : type_(type), id_(next_id_.fetch_add(1, std::memory_order_relaxed)) {
+struct VNode::Index {
+    struct ChildKey {
+        uint64_t parent;
+        std::string key;
+        
+        bool operator==(const ChildKey& other) const {
+            return parent == other.parent && key == other.key;
+        }
+    };
+    
+    struct ChildKeyHash {
+        size_t operator()(const ChildKey& k) const {
+            return static_cast<size_t>(hashCombine(hashMix(k.parent), std::hash<std::string>{}(k.key)));
+        }
+    };
+    
+    struct Slot {
+        VNode* node;
+        std::optional<uint64_t> parentId;  // Kept so entries can be dropped without the parent
+    };
+    
+    std::unordered_map<uint64_t, Slot> byId;
+    std::unordered_map<ChildKey, VNode*, ChildKeyHash> byKey;
+    
+    void add(VNode& node) {
+        auto parent = node.parent_.lock();
+        std::optional<uint64_t> parentId;
+        if (parent) parentId = parent->id_;
+        byId[node.id_] = Slot{&node, parentId};
+        if (node.key_ && parentId) {
+            // With duplicate sibling keys the first one indexed wins
+            byKey.emplace(ChildKey{*parentId, *node.key_}, &node);
+        }
+    }
+    
+    // liveParent, if given, is searched for a sibling to take over the key
+    void remove(VNode& node, const VNode* liveParent) {
+        auto it = byId.find(node.id_);
+        if (it == byId.end()) return;
+        if (node.key_ && it->second.parentId) {
+            removeKey(node, *it->second.parentId, *node.key_, liveParent);
+        }
+        byId.erase(it);
+    }
+    
+    void removeKey(VNode& node, uint64_t parentId, const std::string& key, const VNode* liveParent) {
+        auto it = byKey.find(ChildKey{parentId, key});
+        if (it == byKey.end() || it->second != &node) return;
+        byKey.erase(it);
+        
+        if (!liveParent) return;
+        for (const auto& sibling : liveParent->children_) {
+            if (sibling && sibling.get() != &node && sibling->key_ == key &&
+                sibling->index_.get() == this) {
+                byKey.emplace(ChildKey{parentId, key}, sibling.get());
+                break;
+            }
+        }
+    }
+};
+
+VNode::VNode(VNodeType type, std::pmr::memory_resource* resource) 
+    : type_(type), id_(nextId()), children_(resource), implicitKey_(0), implicitOrdinal_(0),
+      hash_(0), hashValid_(false), unhashedProps_(false), unhashedBelow_(false), stableId_(0), frozen_(false), hoisted_(false) {
 }
 
-VNode::Ptr VNode::createElement(
-    const std::string& tag,
-    const Props& props,
-    const std::vector<Ptr>& children) {
-    
-    auto node = std::make_shared<VNode>(VNodeType::Element);
-    node->tag_ = tag;
-    node->props_ = props;
-    node->children_ = children;
+VNode::~VNode() {
+    // Drop entries of a node destroyed while still indexed (e.g. its tree was
+    // released while a subtree handle outlived it)
+    if (index_) {
+        index_->remove(*this, nullptr);
+    }
     
-    // Set parent for children
-    for (auto& child : node->children_) {
-        if (child) {
-            child->parent_ = node;
+    // A child that outlives this node (e.g. a hoisted subtree) would keep
+    // its expired parent link, and with it the arena block holding this
+    // node's control block. Release the link.
+    WeakPtr self = weak_from_this();
+    for (const auto& child : children_) {
+        if (child && child.use_count() > 1 && !child->parent_.owner_before(self) &&
+            !self.owner_before(child->parent_)) {
+            child->parent_.reset();
         }
     }
+}
+
+uint64_t VNode::nextId() {
+    thread_local uint64_t next = 0;
+    thread_local uint64_t end = 0;
+    if (next == end) {
+        next = next_id_.fetch_add(IdBlockSize, std::memory_order_relaxed);
+        end = next + IdBlockSize;
+    }
+    return next++;
+}
+
+VNode::Ptr VNode::allocate(VNodeType type) {
+    if (NodeBlock* block = NodeBlock::current()) {
+        return std::allocate_shared<VNode>(std::pmr::polymorphic_allocator<VNode>(block), type, block);
+    }
+    if (FrameArena* arena = FrameArena::current()) {
+        // Node, control block and children array all come from the arena
+        return std::allocate_shared<VNode>(std::pmr::polymorphic_allocator<VNode>(arena), type, arena);
+    }
+    return std::make_shared<VNode>(type);
+}
+
+VNode::Ptr VNode::createElement(
+    TagId tag,
+    Props props,
+    std::vector<Ptr> children) {
     
+    auto node = allocate(VNodeType::Element);
+    node->tag_ = tag;
+    node->props_ = std::move(props);
+    node->children_.assign(std::make_move_iterator(children.begin()), std::make_move_iterator(children.end()));
+    node->adoptChildren();
     return node;
 }
 
-VNode::Ptr VNode::createText(const std::string& text) {
-    auto node = std::make_shared<VNode>(VNodeType::Text);
-    node->text_ = text;
+VNode::Ptr VNode::createText(std::string text, Props props) {
+    auto node = allocate(VNodeType::Text);
+    node->text_ = std::move(text);
+    node->props_ = std::move(props);
     return node;
 }
 
 VNode::Ptr VNode::createComponent(
     std::shared_ptr<Component> component,
-    const Props& props,
-    const std::vector<Ptr>& children) {
+    Props props,
+    std::vector<Ptr> children) {
     
-    auto node = std::make_shared<VNode>(VNodeType::Component);
-    node->component_ = component;
-    node->props_ = props;
-    node->children_ = children;
-    
-    for (auto& child : node->children_) {
+    auto node = allocate(VNodeType::Component);
+    node->component_ = std::move(component);
+    node->props_ = std::move(props);
+    node->children_.assign(std::make_move_iterator(children.begin()), std::make_move_iterator(children.end()));
+    node->adoptChildren();
+    return node;
+}
+
+VNode::Ptr VNode::createFragment(std::vector<Ptr> children) {
+    auto node = allocate(VNodeType::Fragment);
+    node->children_.assign(std::make_move_iterator(children.begin()), std::make_move_iterator(children.end()));
+    node->adoptChildren();
+    return node;
+}
+
+void VNode::adoptChildren() {
+    WeakPtr self = weak_from_this();
+    for (auto& child : children_) {
         if (child) {
-            child->parent_ = node;
+            child->parent_ = self;
         }
     }
-    
-    return node;
+    numberImplicitKeys();
 }
 
-VNode::Ptr VNode::createFragment(const std::vector<Ptr>& children) {
-    auto node = std::make_shared<VNode>(VNodeType::Fragment);
-    node->children_ = children;
-    
-    for (auto& child : node->children_) {
-        if (child) {
-            child->parent_ = node;
+void VNode::numberImplicitKeys() {
+    SmallVector<std::pair<uint64_t, uint32_t>, 8> seen;  // Site key -> count so far
+    for (const auto& child : children_) {
+        if (!child || child->implicitKey_ == 0) continue;
+        auto it = std::find_if(seen.begin(), seen.end(),
+                               [&](const auto& entry) { return entry.first == child->implicitKey_; });
+        uint32_t ordinal = 0;
+        if (it != seen.end()) {
+            ordinal = it->second++;
+        } else {
+            seen.emplace_back(child->implicitKey_, 1u);
+        }
+        if (!child->frozen_) {
+            child->implicitOrdinal_ = ordinal;
         }
     }
-    
-    return node;
 }
 
 void VNode::appendChild(Ptr child) {
     if (!child) return;
+    ensureMutable();
     
+    if (child->implicitKey_ != 0 && !child->frozen_) {
+        child->implicitOrdinal_ = 0;
+        for (const auto& sibling : children_) {
+            if (sibling && sibling->implicitKey_ == child->implicitKey_) ++child->implicitOrdinal_;
+        }
+    }
     children_.push_back(child);
     child->parent_ = shared_from_this();
+    if (index_) child->attachIndex(index_);
+    invalidateHash();
+}
+
+void VNode::appendChildren(std::vector<Ptr> children) {
+    ensureMutable();
+    children_.reserve(children_.size() + children.size());
+    
+    WeakPtr self = weak_from_this();
+    for (auto& child : children) {
+        if (!child) continue;
+        child->parent_ = self;
+        if (index_) child->attachIndex(index_);
+        children_.push_back(std::move(child));
+    }
+    numberImplicitKeys();
+    invalidateHash();
 }
 
 void VNode::removeChild(Ptr child) {
     if (!child) return;
+    ensureMutable();
     
     auto it = std::find(children_.begin(), children_.end(), child);
     if (it != children_.end()) {
+        if (index_) child->detachIndex();
         (*it)->parent_.reset();
         children_.erase(it);
+        numberImplicitKeys();
+        invalidateHash();
     }
 }
 
 void VNode::replaceChild(Ptr oldChild, Ptr newChild) {
     if (!oldChild || !newChild) return;
+    ensureMutable();
     
     auto it = std::find(children_.begin(), children_.end(), oldChild);
     if (it != children_.end()) {
+        if (index_) oldChild->detachIndex();
         oldChild->parent_.reset();
         *it = newChild;
         newChild->parent_ = shared_from_this();
+        if (index_) newChild->attachIndex(index_);
+        numberImplicitKeys();
+        invalidateHash();
     }
 }
 
 void VNode::insertBefore(Ptr newChild, Ptr sibling) {
     if (!newChild) return;
+    ensureMutable();
     
     if (!sibling) {
         appendChild(newChild);
@@ -110,161 +262,614 @@ void VNode::insertBefore(Ptr newChild, Ptr sibling) {
     if (it != children_.end()) {
         children_.insert(it, newChild);
         newChild->parent_ = shared_from_this();
+        if (index_) newChild->attachIndex(index_);
+        numberImplicitKeys();
+        invalidateHash();
     } else {
         appendChild(newChild);
     }
 }
 
 void VNode::traversePreOrder(std::function<void(Ptr)> visitor) {
-    visitor(shared_from_this());
-    for (auto& child : children_) {
-        if (child) {
-            child->traversePreOrder(visitor);
-        }
-    }
+    visitPreOrder([&visitor](VNode& node) { visitor(node.shared_from_this()); });
 }
 
 void VNode::traversePostOrder(std::function<void(Ptr)> visitor) {
-    for (auto& child : children_) {
-        if (child) {
-            child->traversePostOrder(visitor);
-        }
-    }
-    visitor(shared_from_this());
+    visitPostOrder([&visitor](VNode& node) { visitor(node.shared_from_this()); });
 }
 
 void VNode::traverseLevelOrder(std::function<void(Ptr)> visitor) {
-    std::queue<Ptr> queue;
-    queue.push(shared_from_this());
+    visitLevelOrder([&visitor](VNode& node) { visitor(node.shared_from_this()); });
+}
+
+void VNode::setKey(const std::optional<std::string>& key) {
+    ensureMutable();
+    if (index_) {
+        auto parent = parent_.lock();
+        index_->remove(*this, parent.get());
+        key_ = key;
+        index_->add(*this);
+    } else {
+        key_ = key;
+    }
+    invalidateHash();
+}
+
+uint64_t VNode::getImplicitKey() const {
+    if (implicitKey_ == 0) {
+        return 0;
+    }
+    uint64_t key = hashMix(hashCombine(implicitKey_, implicitOrdinal_));
+    return key == 0 ? 1 : key;
+}
+
+void VNode::setImplicitKey(uint64_t siteKey) {
+    ensureMutable();
+    implicitKey_ = siteKey;
+    implicitOrdinal_ = 0;
+}
+
+void VNode::enableIndex() {
+    if (index_) return;  // Already covered by this tree's index
+    attachIndex(std::make_shared<Index>());
+}
+
+void VNode::disableIndex() {
+    if (!index_) return;
     
-    while (!queue.empty()) {
-        auto current = queue.front();
-        queue.pop();
-        
-        visitor(current);
-        
-        for (auto& child : current->children_) {
-            if (child) {
-                queue.push(child);
-            }
+    // Drop the index for the whole tree, not just this subtree
+    VNode* root = this;
+    for (auto parent = parent_.lock(); parent && parent->index_ == index_; parent = parent->parent_.lock()) {
+        root = parent.get();
+    }
+    root->detachIndex();
+}
+
+void VNode::attachIndex(const std::shared_ptr<Index>& index) {
+    if (index_ == index) return;
+    
+    // Frozen subtrees may be shared with other trees, so they can't join one index
+    visitPreOrder([](const VNode& node) {
+        if (node.frozen_) {
+            throw std::runtime_error("VNode: frozen subtrees cannot be indexed");
         }
+    });
+    if (index_) detachIndex();  // Moving over from another indexed tree
+    
+    visitPreOrder([&index](VNode& node) {
+        node.index_ = index;
+        index->add(node);
+    });
+}
+
+void VNode::detachIndex() {
+    // Only this node's siblings stay behind; everything below leaves together
+    auto parent = parent_.lock();
+    index_->remove(*this, parent.get());
+    index_.reset();
+    
+    for (const auto& child : children_) {
+        if (!child) continue;
+        child->visitPreOrder([](VNode& node) {
+            if (node.index_) {
+                node.index_->remove(node, nullptr);
+                node.index_.reset();
+            }
+        });
     }
 }
 
+bool VNode::isDescendantOf(const VNode* ancestor) const {
+    const VNode* node = this;
+    while (node) {
+        if (node == ancestor) return true;
+        auto parent = node->parent_.lock();
+        node = parent.get();
+    }
+    return false;
+}
+
 VNode::Ptr VNode::findChildByKey(const std::string& key) const {
+    if (index_) {
+        auto it = index_->byKey.find(Index::ChildKey{id_, key});
+        return it != index_->byKey.end() ? it->second->shared_from_this() : nullptr;
+    }
+    
     for (const auto& child : children_) {
         if (child && child->key_ && *child->key_ == key) {
             return child;
         }
-        if (child) {
-            auto found = child->findChildByKey(key);
-            if (found) return found;
-        }
     }
     return nullptr;
 }
 
+VNode::Ptr VNode::findDescendantByKey(const std::string& key) const {
+    const VNode* found = nullptr;
+    visitPreOrder([&](const VNode& node) {
+        if (&node != this && node.key_ && *node.key_ == key) {
+            found = &node;
+            return VisitResult::Stop;
+        }
+        return VisitResult::Continue;
+    });
+    return found ? const_cast<VNode*>(found)->shared_from_this() : nullptr;
+}
+
 VNode::Ptr VNode::findById(uint64_t id) const {
-    if (id_ == id) {
-        return const_cast<VNode*>(this)->shared_from_this();
+    if (index_) {
+        auto it = index_->byId.find(id);
+        if (it == index_->byId.end() || !it->second.node->isDescendantOf(this)) {
+            return nullptr;
+        }
+        return it->second.node->shared_from_this();
     }
     
-    for (const auto& child : children_) {
-        if (child) {
-            auto found = child->findById(id);
-            if (found) return found;
+    const VNode* found = nullptr;
+    visitPreOrder([&](const VNode& node) {
+        if (node.id_ == id) {
+            found = &node;
+            return VisitResult::Stop;
         }
-    }
-    return nullptr;
+        return VisitResult::Continue;
+    });
+    return found ? const_cast<VNode*>(found)->shared_from_this() : nullptr;
 }
 
 VNode::Ptr VNode::cloneShallow() const {
-    auto cloned = std::make_shared<VNode>(type_);
+    auto cloned = allocate(type_);
     cloned->tag_ = tag_;
     cloned->text_ = text_;
     cloned->props_ = props_;
     cloned->key_ = key_;
+    cloned->implicitKey_ = implicitKey_;
+    cloned->implicitOrdinal_ = implicitOrdinal_;
     cloned->component_ = component_;
     // Don't copy children or parent
     return cloned;
 }
 
 VNode::Ptr VNode::cloneDeep() const {
-    auto cloned = cloneShallow();
+    if (frozen_) {
+        return const_cast<VNode*>(this)->shared_from_this();
+    }
     
-    for (const auto& child : children_) {
-        if (child) {
-            auto clonedChild = child->cloneDeep();
-            cloned->appendChild(clonedChild);
+    Ptr cloned;
+    SmallVector<VNode*, InlineTraversalDepth> parents;
+    
+    visitDepthFirst(
+        [&](const VNode& node) {
+            if (node.frozen_) {
+                // Immutable, so the subtree can be shared as is
+                parents.back()->appendChild(const_cast<VNode&>(node).shared_from_this());
+                return VisitResult::SkipChildren;
+            }
+            
+            auto copy = node.cloneShallow();
+            if (parents.empty()) {
+                cloned = copy;
+            } else {
+                parents.back()->appendChild(copy);
+            }
+            parents.push_back(copy.get());
+            return VisitResult::Continue;
+        },
+        [&](const VNode& node) {
+            if (!node.frozen_) parents.pop_back();
+        });
+    
+    return cloned;
+}
+
+void VNode::freeze() {
+    visitPreOrder([](VNode& node) {
+        if (node.frozen_) {
+            return VisitResult::SkipChildren;  // Frozen nodes only have frozen children
+        }
+        if (node.index_) {
+            throw std::runtime_error("VNode: disable the index before freezing a tree");
+        }
+        node.frozen_ = true;
+        return VisitResult::Continue;
+    });
+}
+
+VNode::Ptr VNode::hoist(Ptr node) {
+    if (!node) return node;
+    node->freeze();
+    node->structuralHash();
+    node->hoisted_ = true;
+    return node;
+}
+
+bool VNode::isStatic() const {
+    return visitPreOrder([](const VNode& node) {
+        if (node.type_ == VNodeType::Component) {
+            return VisitResult::Stop;
+        }
+        for (const auto& entry : node.props_.entries()) {
+            if (PropComparators::isHandler(entry.type)) {
+                return VisitResult::Stop;
+            }
+        }
+        return VisitResult::Continue;
+    });
+}
+
+VNode::Ptr VNode::cloneForEdit() const {
+    auto copy = cloneShallow();
+    copy->children_.assign(children_.begin(), children_.end());
+    copy->adoptChildren();
+    copy->hash_ = hash_;
+    copy->hashValid_ = hashValid_;
+    copy->unhashedProps_ = unhashedProps_;
+    copy->unhashedBelow_ = unhashedBelow_;
+    return copy;
+}
+
+VNode::Ptr VNode::withProps(Props props) const {
+    auto copy = cloneForEdit();
+    copy->getProps() = std::move(props);
+    copy->freeze();
+    return copy;
+}
+
+VNode::Ptr VNode::withKey(const std::optional<std::string>& key) const {
+    auto copy = cloneForEdit();
+    copy->setKey(key);
+    copy->freeze();
+    return copy;
+}
+
+VNode::Ptr VNode::withChildAppended(Ptr child) const {
+    auto copy = cloneForEdit();
+    copy->appendChild(std::move(child));
+    copy->freeze();
+    return copy;
+}
+
+VNode::Ptr VNode::withChildInserted(Ptr newChild, const Ptr& sibling) const {
+    auto copy = cloneForEdit();
+    copy->insertBefore(std::move(newChild), sibling);
+    copy->freeze();
+    return copy;
+}
+
+VNode::Ptr VNode::withChildRemoved(const Ptr& child) const {
+    auto copy = cloneForEdit();
+    auto it = std::find(copy->children_.begin(), copy->children_.end(), child);
+    if (it != copy->children_.end()) {
+        // Not removeChild: the child still belongs to this (older) tree
+        (*it)->parent_ = const_cast<VNode*>(this)->weak_from_this();
+        copy->children_.erase(it);
+        copy->invalidateHash();
+    }
+    copy->freeze();
+    return copy;
+}
+
+VNode::Ptr VNode::withChildReplaced(const Ptr& oldChild, Ptr newChild) const {
+    auto copy = cloneForEdit();
+    auto it = std::find(copy->children_.begin(), copy->children_.end(), oldChild);
+    if (it != copy->children_.end() && newChild) {
+        (*it)->parent_ = const_cast<VNode*>(this)->weak_from_this();
+        *it = std::move(newChild);
+        (*it)->parent_ = copy;
+        copy->invalidateHash();
+    }
+    copy->freeze();
+    return copy;
+}
+
+VNode::Ptr VNode::updateIn(const Ptr& root, const VNode& target, const std::function<void(VNode&)>& edit) {
+    if (!root || !root->frozen_) {
+        throw std::runtime_error("VNode::updateIn: root must be a frozen tree");
+    }
+    
+    // Path from target up to root. Parent links follow the newest tree, so
+    // fall back to a search if they lead elsewhere.
+    std::vector<const VNode*> path;
+    for (const VNode* node = &target; node; ) {
+        path.push_back(node);
+        if (node == root.get()) break;
+        auto parent = node->parent_.lock();
+        if (parent && std::none_of(parent->children_.begin(), parent->children_.end(),
+                                   [node](const Ptr& child) { return child.get() == node; })) {
+            break;  // Stale link
         }
+        node = parent.get();
     }
     
-    return cloned;
+    if (path.back() != root.get()) {
+        path.clear();
+        std::vector<const VNode*> stack;
+        std::as_const(*root).visitDepthFirst(
+            [&](const VNode& node) {
+                stack.push_back(&node);
+                if (&node == &target) {
+                    path.assign(stack.rbegin(), stack.rend());
+                    return VisitResult::Stop;
+                }
+                return VisitResult::Continue;
+            },
+            [&](const VNode&) { stack.pop_back(); });
+        
+        if (path.empty()) {
+            throw std::runtime_error("VNode::updateIn: target is not in the tree");
+        }
+    }
+    
+    Ptr updated = target.cloneForEdit();
+    edit(*updated);
+    updated->freeze();
+    
+    // Copy each ancestor, swapping in the updated child
+    for (size_t i = 1; i < path.size(); ++i) {
+        const VNode* child = path[i - 1];
+        auto copy = path[i]->cloneForEdit();
+        for (auto& slot : copy->children_) {
+            if (slot.get() == child) {
+                slot = updated;
+                break;
+            }
+        }
+        updated->parent_ = copy;
+        copy->hashValid_ = false;
+        copy->frozen_ = true;
+        updated = copy;
+    }
+    return updated;
+}
+
+void VNode::ensureMutable() const {
+    if (frozen_) {
+        throw std::runtime_error("VNode: cannot modify a frozen node");
+    }
 }
 
 std::string VNode::serialize() const {
     std::ostringstream oss;
     
-    switch (type_) {
-        case VNodeType::Element:
-            oss << "<" << tag_;
-            if (key_) {
-                oss << " key=\"" << *key_ << "\"";
+    visitDepthFirst(
+        [&oss](const VNode& node) {
+            switch (node.type_) {
+                case VNodeType::Element:
+                    oss << "<" << node.tag_.name();
+                    if (node.key_) {
+                        oss << " key=\"" << *node.key_ << "\"";
+                    }
+                    oss << " id=\"" << node.id_ << "\"";
+                    oss << ">";
+                    break;
+                case VNodeType::Text:
+                    oss << node.text_;
+                    break;
+                case VNodeType::Component:
+                    oss << "<Component id=\"" << node.id_ << "\">";
+                    break;
+                case VNodeType::Fragment:
+                    oss << "<Fragment>";
+                    break;
             }
-            oss << " id=\"" << id_ << "\"";
-            oss << ">";
-            for (const auto& child : children_) {
-                if (child) {
-                    oss << child->serialize();
-                }
+        },
+        [&oss](const VNode& node) {
+            switch (node.type_) {
+                case VNodeType::Element:
+                    oss << "</" << node.tag_.name() << ">";
+                    break;
+                case VNodeType::Text:
+                    break;
+                case VNodeType::Component:
+                    oss << "</Component>";
+                    break;
+                case VNodeType::Fragment:
+                    oss << "</Fragment>";
+                    break;
             }
-            oss << "</" << tag_ << ">";
-            break;
-            
-        case VNodeType::Text:
-            oss << text_;
-            break;
-            
-        case VNodeType::Component:
-            oss << "<Component id=\"" << id_ << "\">";
-            for (const auto& child : children_) {
-                if (child) {
-                    oss << child->serialize();
-                }
+        });
+    
+    return oss.str();
+}
+
+StableId VNode::deriveStableId(StableId parentStableId, const VNode& node, size_t index,
+                               size_t keyOccurrence) {
+    // Keys, implicit keys and positions hash into separate domains so key
+    // "0" and index 0 differ. A repeated key adds its occurrence count.
+    uint64_t slot = node.key_           ? hashCombine(1, std::hash<std::string>{}(*node.key_))
+                    : node.implicitKey_ ? hashCombine(3, node.getImplicitKey())
+                                        : hashCombine(2, index);
+    if (node.key_ && keyOccurrence != 0) {
+        slot = hashCombine(slot, keyOccurrence);
+    }
+    uint64_t id = hashCombine(parentStableId, slot);
+    id = hashCombine(id, static_cast<uint64_t>(node.type_));
+    id = hashCombine(id, node.tag_.id());
+    if (node.component_) {
+        id = hashCombine(id, node.component_->getId());
+    }
+    id = hashMix(id);
+    return id == 0 ? 1 : id;  // 0 means unassigned
+}
+
+StableId ChildStableIds::next(const VNode& child) {
+    size_t index = index_++;
+    const auto& key = child.getKey();
+    if (!key) {
+        return VNode::deriveStableId(parent_, child, index);
+    }
+    size_t occurrence = keys_[*key]++;
+    return VNode::deriveStableId(parent_, child, index, occurrence);
+}
+
+StableId VNode::getStableId() const {
+    if (stableId_ != 0) {
+        return stableId_;
+    }
+    
+    // Collect the path up to the first node with a cached id (or the root),
+    // then derive downwards. Parents are held so the path stays alive.
+    std::vector<std::shared_ptr<const VNode>> parents;
+    std::vector<const VNode*> path{this};
+    while (path.back()->stableId_ == 0) {
+        auto parent = path.back()->parent_.lock();
+        if (!parent) break;
+        path.push_back(parent.get());
+        parents.push_back(std::move(parent));
+    }
+    
+    StableId id = path.back()->stableId_ != 0 ? path.back()->stableId_
+                                              : deriveStableId(0, *path.back(), 0);
+    for (size_t i = path.size() - 1; i-- > 0;) {
+        const VNode* node = path[i];
+        ChildStableIds siblings(id);
+        for (const auto& sibling : path[i + 1]->children_) {
+            if (!sibling) continue;
+            StableId siblingId = siblings.next(*sibling);
+            if (sibling.get() == node) {
+                id = siblingId;
+                break;
             }
-            oss << "</Component>";
-            break;
-            
-        case VNodeType::Fragment:
-            oss << "<Fragment>";
-            for (const auto& child : children_) {
-                if (child) {
-                    oss << child->serialize();
+        }
+    }
+    return id;
+}
+
+void VNode::assignStableIds() const {
+    // Children are assigned by their parent, which is visited first. A
+    // hoisted subtree whose root keeps its id still holds the ids assigned
+    // when it was last placed there, so it is skipped.
+    stableId_ = 0;
+    stableId_ = getStableId();
+    SmallVector<const VNode*, 8> unchanged;
+    visitPreOrder([&unchanged](const VNode& node) {
+        if (node.hoisted_) {
+            for (const VNode* hoisted : unchanged) {
+                if (hoisted == &node) return VisitResult::SkipChildren;
+            }
+        }
+        ChildStableIds ids(node.stableId_);
+        for (const auto& child : node.children_) {
+            if (child) {
+                StableId id = ids.next(*child);
+                if (child->hoisted_ && child->stableId_ == id) {
+                    unchanged.push_back(child.get());
                 }
+                child->stableId_ = id;
             }
-            oss << "</Fragment>";
-            break;
+        }
+        return VisitResult::Continue;
+    });
+}
+
+uint64_t VNode::structuralHash() const {
+    if (hashValid_) {
+        return hash_;
     }
     
-    return oss.str();
+    // Hash bottom-up, skipping subtrees whose hash is still cached
+    visitDepthFirst(
+        [](const VNode& node) {
+            return node.hashValid_ ? VisitResult::SkipChildren : VisitResult::Continue;
+        },
+        [](const VNode& node) {
+            if (!node.hashValid_) {
+                node.hash_ = node.computeHash();
+                node.hashValid_ = true;
+            }
+        });
+    return hash_;
 }
 
-bool VNode::operator==(const VNode& other) const {
-    if (type_ != other.type_) return false;
-    if (tag_ != other.tag_) return false;
-    if (text_ != other.text_) return false;
-    if (key_ != other.key_) return false;
-    if (props_ != other.props_) return false;
-    if (children_.size() != other.children_.size()) return false;
-    
-    for (size_t i = 0; i < children_.size(); ++i) {
-        if (children_[i] && other.children_[i]) {
-            if (*children_[i] != *other.children_[i]) return false;
-        } else if (children_[i] != other.children_[i]) {
-            return false;
+uint64_t VNode::computeHash() const {
+    // Expects all children to have valid hashes
+    unhashedProps_ = !props_.isFullyHashed();
+    unhashedBelow_ = unhashedProps_;
+    for (const auto& child : children_) {
+        unhashedBelow_ = unhashedBelow_ || (child && child->unhashedBelow_);
+    }
+    
+    uint64_t hash = hashMix(static_cast<uint64_t>(type_));
+    hash = hashCombine(hash, tag_.id());
+    hash = hashCombine(hash, std::hash<std::string>{}(text_));
+    hash = hashCombine(hash, key_ ? std::hash<std::string>{}(*key_) + 1 : 0);
+    hash = hashCombine(hash, props_.hash());
+    hash = hashCombine(hash, reinterpret_cast<uintptr_t>(component_.get()));
+    hash = hashCombine(hash, children_.size());
+    for (const auto& child : children_) {
+        hash = hashCombine(hash, child ? child->hash_ : 0);
+    }
+    return hash;
+}
+
+void VNode::invalidateHash() {
+    // A valid hash implies valid hashes below it, so stop at the first
+    // ancestor that is already invalid
+    if (!hashValid_) return;
+    hashValid_ = false;
+    
+    auto parent = parent_.lock();
+    while (parent && parent->hashValid_) {
+        parent->hashValid_ = false;
+        parent = parent->parent_.lock();
+    }
+}
+
+bool VNode::isSameSubtree(const VNode& other) const {
+    if (this == &other) return true;
+    if (structuralHash() != other.structuralHash()) return false;
+    if (!unhashedBelow_ && !other.unhashedBelow_) return true;
+    
+    // Equal hashes: compare the props the hash ignores, descending only
+    // into subtrees that have some
+    std::vector<std::pair<const VNode*, const VNode*>> pending{{this, &other}};
+    while (!pending.empty()) {
+        auto [a, b] = pending.back();
+        pending.pop_back();
+        if (a == b || (!a->unhashedBelow_ && !b->unhashedBelow_)) continue;
+        if ((a->unhashedProps_ || b->unhashedProps_) && a->props_ != b->props_) return false;
+        if (a->children_.size() != b->children_.size()) return false;
+        for (size_t i = 0; i < a->children_.size(); ++i) {
+            const auto& first = a->children_[i];
+            const auto& second = b->children_[i];
+            if (first && second) {
+                pending.emplace_back(first.get(), second.get());
+            } else if (first || second) {
+                return false;
+            }
         }
     }
+    return true;
+}
+
+bool VNode::operator==(const VNode& other) const {
+    if (this == &other) return true;
+    if (structuralHash() != other.structuralHash()) return false;
     
+    // Equal hashes: compare fields to rule out a collision. Hashes below
+    // are valid once the roots' are.
+    std::vector<std::pair<const VNode*, const VNode*>> pending{{this, &other}};
+    while (!pending.empty()) {
+        auto [a, b] = pending.back();
+        pending.pop_back();
+        if (a == b) continue;
+        if (a->hash_ != b->hash_) return false;
+        if (a->type_ != b->type_) return false;
+        if (a->tag_ != b->tag_) return false;
+        if (a->text_ != b->text_) return false;
+        if (a->key_ != b->key_) return false;
+        if (a->props_ != b->props_) return false;
+        if (a->component_ != b->component_) return false;
+        if (a->children_.size() != b->children_.size()) return false;
+        
+        for (size_t i = 0; i < a->children_.size(); ++i) {
+            const auto& first = a->children_[i];
+            const auto& second = b->children_[i];
+            if (first && second) {
+                pending.emplace_back(first.get(), second.get());
+            } else if (first || second) {
+                return false;
+            }
+        }
+    }
     return true;
 }
 
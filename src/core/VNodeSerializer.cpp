@@ -0,0 +1,436 @@
+#include "reactpp/core/VNodeSerializer.hpp"
+#include "reactpp/renderer/RendererTypes.hpp"
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <typeindex>
+
+namespace reactpp {
+
+namespace {
+
+constexpr char Magic[4] = {'R', 'P', 'V', 'N'};
+constexpr uint8_t FormatVersion = 1;
+constexpr size_t FlushThreshold = 64 * 1024;
+
+// Node header byte: type in the low bits, then presence flags
+constexpr uint8_t TypeMask = 0x03;
+constexpr uint8_t HasKey = 0x04;
+constexpr uint8_t HasProps = 0x08;
+constexpr uint8_t HasChildren = 0x10;
+
+enum class ValueCode : uint8_t {
+    None = 0,
+    Int,
+    UInt32,
+    Float,
+    Double,
+    Bool,
+    String,
+    Gradient
+};
+
+using GradientStops = std::vector<renderer::GradientStop>;
+
+ValueCode valueCode(const std::type_index& type) {
+    if (type == typeid(int)) return ValueCode::Int;
+    if (type == typeid(uint32_t)) return ValueCode::UInt32;
+    if (type == typeid(float)) return ValueCode::Float;
+    if (type == typeid(double)) return ValueCode::Double;
+    if (type == typeid(bool)) return ValueCode::Bool;
+    if (type == typeid(std::string)) return ValueCode::String;
+    if (type == typeid(GradientStops)) return ValueCode::Gradient;
+    return ValueCode::None;
+}
+
+uint32_t floatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+// ---- Writer ----
+
+VNodeWriter::VNodeWriter(std::ostream& out)
+    : out_(out), written_(0) {
+    buffer_.append(Magic, sizeof(Magic));
+    putByte(FormatVersion);
+}
+
+VNodeWriter::~VNodeWriter() {
+    try {
+        flush();
+    } catch (...) {}
+}
+
+void VNodeWriter::write(const VNode& root) {
+    root.visitPreOrder([this](const VNode& node) {
+        writeNode(node);
+        if (buffer_.size() >= FlushThreshold) {
+            flush();
+        }
+    });
+}
+
+void VNodeWriter::flush() {
+    if (buffer_.empty()) return;
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    if (!out_) {
+        throw std::runtime_error("VNodeWriter: failed to write to stream");
+    }
+    written_ += buffer_.size();
+    buffer_.clear();
+}
+
+void VNodeWriter::writeNode(const VNode& node) {
+    size_t childCount = 0;
+    for (const auto& child : node.getChildren()) {
+        if (child) ++childCount;
+    }
+
+    uint8_t header = static_cast<uint8_t>(node.getType());
+    if (node.getKey()) header |= HasKey;
+    if (!node.getProps().empty()) header |= HasProps;
+    if (childCount > 0) header |= HasChildren;
+    putByte(header);
+
+    switch (node.getType()) {
+        case VNodeType::Element:
+            writeName(tagRefs_, node.getTagId().id(), node.getTag());
+            break;
+        case VNodeType::Text:
+            putString(node.getText());
+            break;
+        case VNodeType::Component:
+        case VNodeType::Fragment:
+            break;
+    }
+
+    if (node.getKey()) putString(*node.getKey());
+    if (header & HasProps) writeProps(node.getProps());
+    if (childCount > 0) putVarint(childCount);
+}
+
+void VNodeWriter::writeProps(const Props& props) {
+    const BuiltinProps& fields = props.builtins();
+    size_t count = fields.size();
+    for (const auto& entry : props.entries()) {
+        if (valueCode(entry.type) != ValueCode::None) ++count;
+    }
+    putVarint(count);
+    
+    // Typed fields use the same value codes, so readers need not tell them apart
+    for (uint8_t i = 0; i < BuiltinProps::FieldCount; ++i) {
+        auto field = static_cast<BuiltinProps::Field>(i);
+        if (!fields.has(field)) continue;
+        
+        PropKey key = BuiltinProps::keyOf(field);
+        writeName(keyRefs_, key.id(), key.name());
+        if (BuiltinProps::isColor(field)) {
+            putByte(static_cast<uint8_t>(ValueCode::UInt32));
+            putVarint(fields.raw(field));
+        } else {
+            putByte(static_cast<uint8_t>(ValueCode::Int));
+            putVarint(zigzag(static_cast<int32_t>(fields.raw(field))));
+        }
+    }
+
+    for (const auto& entry : props.entries()) {
+        ValueCode code = valueCode(entry.type);
+        if (code == ValueCode::None) continue;
+
+        writeName(keyRefs_, entry.key.id(), entry.key.name());
+        putByte(static_cast<uint8_t>(code));
+        switch (code) {
+            case ValueCode::Int:
+                putVarint(zigzag(*std::any_cast<int>(&entry.value)));
+                break;
+            case ValueCode::UInt32:
+                putVarint(*std::any_cast<uint32_t>(&entry.value));
+                break;
+            case ValueCode::Float:
+                putFixed(floatBits(*std::any_cast<float>(&entry.value)), 4);
+                break;
+            case ValueCode::Double:
+                putFixed(doubleBits(*std::any_cast<double>(&entry.value)), 8);
+                break;
+            case ValueCode::Bool:
+                putByte(*std::any_cast<bool>(&entry.value) ? 1 : 0);
+                break;
+            case ValueCode::String:
+                putString(*std::any_cast<std::string>(&entry.value));
+                break;
+            case ValueCode::Gradient: {
+                const auto& stops = *std::any_cast<GradientStops>(&entry.value);
+                putVarint(stops.size());
+                for (const auto& stop : stops) {
+                    putFixed(floatBits(stop.position), 4);
+                    putFixed(stop.color, 4);
+                }
+                break;
+            }
+            case ValueCode::None:
+                break;
+        }
+    }
+}
+
+void VNodeWriter::writeName(std::unordered_map<uint32_t, uint32_t>& refs, uint32_t id, const std::string& name) {
+    // 0 introduces a new name; later uses refer to it by 1-based index
+    auto it = refs.find(id);
+    if (it != refs.end()) {
+        putVarint(it->second);
+        return;
+    }
+    putVarint(0);
+    putString(name);
+    refs.emplace(id, static_cast<uint32_t>(refs.size() + 1));
+}
+
+void VNodeWriter::putByte(uint8_t byte) {
+    buffer_.push_back(static_cast<char>(byte));
+}
+
+void VNodeWriter::putVarint(uint64_t value) {
+    while (value >= 0x80) {
+        putByte(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    putByte(static_cast<uint8_t>(value));
+}
+
+void VNodeWriter::putFixed(uint64_t value, size_t bytes) {
+    // Little-endian regardless of host order
+    for (size_t i = 0; i < bytes; ++i) {
+        putByte(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void VNodeWriter::putString(std::string_view value) {
+    putVarint(value.size());
+    buffer_.append(value.data(), value.size());
+}
+
+// ---- Reader ----
+
+VNodeReader::VNodeReader(std::string_view data)
+    : data_(data), pos_(0) {
+    require(sizeof(Magic) + 1);
+    if (std::memcmp(data_.data(), Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("VNodeReader: not a VNode stream");
+    }
+    pos_ = sizeof(Magic);
+    uint8_t version = getByte();
+    if (version != FormatVersion) {
+        throw std::runtime_error("VNodeReader: unsupported format version " + std::to_string(version));
+    }
+}
+
+VNode::Ptr VNodeReader::read() {
+    struct Pending {
+        VNode::Ptr node;
+        uint64_t remaining;
+    };
+
+    uint64_t childCount = 0;
+    VNode::Ptr root = readNode(childCount);
+    if (childCount == 0) {
+        return root;
+    }
+
+    std::vector<Pending> stack;
+    stack.push_back({root, childCount});
+    while (!stack.empty()) {
+        Pending& top = stack.back();
+        if (top.remaining == 0) {
+            stack.pop_back();
+            continue;
+        }
+        --top.remaining;
+
+        VNode::Ptr child = readNode(childCount);
+        top.node->appendChild(child);
+        if (childCount > 0) {
+            stack.push_back({child, childCount});
+        }
+    }
+    return root;
+}
+
+VNode::Ptr VNodeReader::readNode(uint64_t& childCount) {
+    uint8_t header = getByte();
+    uint8_t type = header & TypeMask;
+
+    VNode::Ptr node;
+    switch (static_cast<VNodeType>(type)) {
+        case VNodeType::Element:
+            node = VNode::createElement(TagId(getName(tags_, true)));
+            break;
+        case VNodeType::Text:
+            node = VNode::createText(std::string(getString()));
+            break;
+        case VNodeType::Component:
+            node = VNode::createComponent(nullptr);
+            break;
+        case VNodeType::Fragment:
+            node = VNode::createFragment();
+            break;
+    }
+
+    if (header & HasKey) {
+        node->setKey(std::string(getString()));
+    }
+    if (header & HasProps) {
+        readProps(node->getProps());
+    }
+
+    childCount = (header & HasChildren) ? getVarint() : 0;
+    // Every child takes at least one byte
+    if (childCount > data_.size() - pos_) {
+        throw std::runtime_error("VNodeReader: child count exceeds input");
+    }
+    return node;
+}
+
+void VNodeReader::readProps(Props& props) {
+    uint64_t count = getVarint();
+    for (uint64_t i = 0; i < count; ++i) {
+        PropKey key(getName(keys_, false));
+        auto code = static_cast<ValueCode>(getByte());
+        switch (code) {
+            case ValueCode::Int:
+                props.set(key, static_cast<int>(unzigzag(getVarint())));
+                break;
+            case ValueCode::UInt32:
+                props.set(key, static_cast<uint32_t>(getVarint()));
+                break;
+            case ValueCode::Float: {
+                uint32_t bits = static_cast<uint32_t>(getFixed(4));
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                props.set(key, value);
+                break;
+            }
+            case ValueCode::Double: {
+                uint64_t bits = getFixed(8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                props.set(key, value);
+                break;
+            }
+            case ValueCode::Bool:
+                props.set(key, getByte() != 0);
+                break;
+            case ValueCode::String:
+                props.set(key, std::string(getString()));
+                break;
+            case ValueCode::Gradient: {
+                uint64_t size = getVarint();
+                // Checked before allocating; size * 8 could overflow
+                if (size > (data_.size() - pos_) / 8) {
+                    throw std::runtime_error("VNodeReader: gradient size exceeds input");
+                }
+                GradientStops stops(size);
+                for (auto& stop : stops) {
+                    uint32_t bits = static_cast<uint32_t>(getFixed(4));
+                    std::memcpy(&stop.position, &bits, sizeof(stop.position));
+                    stop.color = static_cast<uint32_t>(getFixed(4));
+                }
+                props.set(key, std::move(stops));
+                break;
+            }
+            default:
+                throw std::runtime_error("VNodeReader: unknown value type " +
+                                         std::to_string(static_cast<int>(code)));
+        }
+    }
+}
+
+uint8_t VNodeReader::getByte() {
+    require(1);
+    return static_cast<uint8_t>(data_[pos_++]);
+}
+
+uint64_t VNodeReader::getVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = getByte();
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("VNodeReader: malformed varint");
+}
+
+uint64_t VNodeReader::getFixed(size_t bytes) {
+    require(bytes);
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data_[pos_ + i])) << (8 * i);
+    }
+    pos_ += bytes;
+    return value;
+}
+
+std::string_view VNodeReader::getString() {
+    uint64_t size = getVarint();
+    require(size);
+    std::string_view value = data_.substr(pos_, size);
+    pos_ += size;
+    return value;
+}
+
+uint32_t VNodeReader::getName(std::vector<uint32_t>& names, bool isTag) {
+    uint64_t ref = getVarint();
+    if (ref == 0) {
+        std::string_view name = getString();
+        uint32_t id = isTag ? TagId::intern(name).id() : PropKey::intern(name).id();
+        names.push_back(id);
+        return id;
+    }
+    if (ref > names.size()) {
+        throw std::runtime_error("VNodeReader: name reference out of range");
+    }
+    return names[ref - 1];
+}
+
+void VNodeReader::require(size_t bytes) const {
+    if (bytes > data_.size() - pos_) {
+        throw std::runtime_error("VNodeReader: unexpected end of input");
+    }
+}
+
+// ---- Helpers ----
+
+std::string encodeTree(const VNode& root) {
+    std::ostringstream out;
+    {
+        VNodeWriter writer(out);
+        writer.write(root);
+    }
+    return out.str();
+}
+
+VNode::Ptr decodeTree(std::string_view data) {
+    VNodeReader reader(data);
+    return reader.read();
+}
+
+} // namespace reactpp
@@ -1,4 +1,5 @@
 #include "reactpp/events/EventManager.hpp"
+#include <unordered_set>
 
 namespace reactpp {
 namespace events {
@@ -6,18 +7,18 @@ namespace events {
 EventManager::EventManager() {
 }
 
-void EventManager::registerHandler(uint64_t nodeId, const std::string& eventType, EventDispatcher::Handler handler) {
-    HandlerKey key(nodeId, eventType);
+void EventManager::registerHandler(StableId stableId, const std::string& eventType, EventDispatcher::Handler handler) {
+    HandlerKey key(stableId, eventType);
     handlers_[key].push_back(handler);
 }
 
-void EventManager::unregisterHandler(uint64_t nodeId, const std::string& eventType) {
-    HandlerKey key(nodeId, eventType);
+void EventManager::unregisterHandler(StableId stableId, const std::string& eventType) {
+    HandlerKey key(stableId, eventType);
     handlers_.erase(key);
 }
 
-std::vector<EventDispatcher::Handler> EventManager::getHandlers(uint64_t nodeId, const std::string& eventType) const {
-    HandlerKey key(nodeId, eventType);
+std::vector<EventDispatcher::Handler> EventManager::getHandlers(StableId stableId, const std::string& eventType) const {
+    HandlerKey key(stableId, eventType);
     auto it = handlers_.find(key);
     if (it != handlers_.end()) {
         return it->second;
@@ -25,11 +26,30 @@ std::vector<EventDispatcher::Handler> EventManager::getHandlers(uint64_t nodeId,
     return {};
 }
 
-void EventManager::cleanupNode(uint64_t nodeId) {
+void EventManager::cleanupNode(StableId stableId) {
     // Remove all handlers for this node
     auto it = handlers_.begin();
     while (it != handlers_.end()) {
-        if (it->first.first == nodeId) {
+        if (it->first.first == stableId) {
+            it = handlers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void EventManager::retainTree(VNode::Ptr root) {
+    std::unordered_set<StableId> live;
+    if (root) {
+        root->assignStableIds();
+        root->visitPreOrder([&live](const VNode& node) {
+            live.insert(node.getStableId());
+        });
+    }
+    
+    auto it = handlers_.begin();
+    while (it != handlers_.end()) {
+        if (!live.count(it->first.first)) {
             it = handlers_.erase(it);
         } else {
             ++it;
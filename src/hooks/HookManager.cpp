@@ -4,7 +4,7 @@
 namespace reactpp {
 
 HookManager::HookManager()
-    : currentIndex_(0), dirty_(false), componentId_(0) {
+    : currentIndex_(0), dirty_(false), marks_(0), componentId_(0) {
 }
 
 void HookManager::reset() {
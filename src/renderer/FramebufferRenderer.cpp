@@ -1,12 +1,15 @@
 #ifdef __linux__
 
 #include "reactpp/renderer/FramebufferRenderer.hpp"
+#include "reactpp/core/HandlerTable.hpp"
 #include "reactpp/core/Props.hpp"
 #include "reactpp/elements/Elements.hpp"
 #include <stdexcept>
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
@@ -592,203 +595,134 @@ void FramebufferRenderer::unpackColor(uint32_t color, uint8_t& r, uint8_t& g, ui
     a = color & 0xFF;
 }
 
-uint32_t FramebufferRenderer::getColorFromProps(const Props& props, const std::string& key, uint32_t defaultColor) {
-    if (props.has(key)) {
-        try {
-            if (props.getType(key) == std::type_index(typeid(uint32_t))) {
-                return props.get<uint32_t>(key);
-            } else if (props.getType(key) == std::type_index(typeid(std::string))) {
-                std::string colorStr = props.get<std::string>(key);
-                if (colorStr.size() >= 7 && colorStr[0] == '#') {
-                    uint32_t color = 0;
-                    for (size_t i = 1; i < colorStr.size() && i < 9; i++) {
-                        char c = colorStr[i];
-                        uint32_t val = 0;
-                        if (c >= '0' && c <= '9') val = c - '0';
-                        else if (c >= 'A' && c <= 'F') val = c - 'A' + 10;
-                        else if (c >= 'a' && c <= 'f') val = c - 'a' + 10;
-                        else continue;
-                        color = (color << 4) | val;
-                    }
-                    if (colorStr.size() == 7) {
-                        color = (color << 8) | 0xFF;
-                    }
-                    return color;
-                }
+uint32_t FramebufferRenderer::getColorFromProps(const Props& props, PropKey key, uint32_t defaultColor) {
+    // Numeric colors are typed fields; "#RRGGBB" strings are generic entries
+    if (auto field = BuiltinProps::fieldOf(key); field && props.builtins().has(*field)) {
+        return props.builtins().raw(*field);
+    }
+    uint32_t color = defaultColor;
+    props.visit<uint32_t, std::string>(key, [&color](const auto& value) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(value)>, uint32_t>) {
+            color = value;
+        } else if (value.size() >= 7 && value[0] == '#') {
+            uint32_t parsed = 0;
+            for (size_t i = 1; i < value.size() && i < 9; i++) {
+                char c = value[i];
+                uint32_t val = 0;
+                if (c >= '0' && c <= '9') val = c - '0';
+                else if (c >= 'A' && c <= 'F') val = c - 'A' + 10;
+                else if (c >= 'a' && c <= 'f') val = c - 'a' + 10;
+                else continue;
+                parsed = (parsed << 4) | val;
+            }
+            if (value.size() == 7) {
+                parsed = (parsed << 8) | 0xFF;
             }
-        } catch (...) {
-            // Fall through to default
+            color = parsed;
         }
-    }
-    return defaultColor;
+    });
+    return color;
 }
 
 Rect FramebufferRenderer::getRectFromProps(const Props& props, const Rect& defaultRect) {
-    Rect rect = defaultRect;
-    
-    if (props.has("x")) {
-        try {
-            rect.x = props.get<int>("x");
-        } catch (...) {}
-    }
-    if (props.has("y")) {
-        try {
-            rect.y = props.get<int>("y");
-        } catch (...) {}
-    }
-    if (props.has("width")) {
-        try {
-            rect.width = props.get<int>("width");
-        } catch (...) {}
-    }
-    if (props.has("height")) {
-        try {
-            rect.height = props.get<int>("height");
-        } catch (...) {}
-    }
-    
-    return rect;
+    const BuiltinProps& fields = props.builtins();
+    return {fields.getOr<BuiltinProps::X>(defaultRect.x),
+            fields.getOr<BuiltinProps::Y>(defaultRect.y),
+            fields.getOr<BuiltinProps::Width>(defaultRect.width),
+            fields.getOr<BuiltinProps::Height>(defaultRect.height)};
 }
 
 void FramebufferRenderer::renderVNode(VNode::Ptr node, int offsetX, int offsetY) {
     if (!node) return;
     
+    // Read through const references so painting keeps cached subtree hashes
+    const VNode& vnode = *node;
+    const Props& props = vnode.getProps();
+    
     switch (node->getType()) {
         case VNodeType::Element: {
-            std::string tag = node->getTag();
+            const TagId tag = vnode.getTagId();
             
-            if (tag == "Button") {
-                Rect layout = getRectFromProps(node->getProps(), {offsetX, offsetY, 150, 40});
-                elementLayouts_[node->getId()] = layout;
-                
-                uint32_t bgColor = getColorFromProps(node->getProps(), "backgroundColor", 0x4A90E2FF);
-                uint32_t borderColor = getColorFromProps(node->getProps(), "borderColor", 0x357ABDFF);
-                uint32_t textColor = getColorFromProps(node->getProps(), "color", 0xFFFFFFFF);
-                
-                fillRect(layout, bgColor);
-                drawRect(layout, borderColor);
-                
-                int textX = layout.x + layout.width / 2;
-                int textY = layout.y + layout.height / 2;
-                for (const auto& child : node->getChildren()) {
-                    if (child) {
-                        if (child->getType() == VNodeType::Text) {
-                            std::string text = child->getText();
-                            if (!text.empty()) {
-                                int fontSize = 14;
-                                if (node->getProps().has("fontSize")) {
-                                    try {
-                                        fontSize = node->getProps().get<int>("fontSize");
-                                    } catch (...) {}
-                                }
-                                int textW, textH;
-                                getTextSize(text, fontSize, textW, textH);
-                                drawText(textX - textW / 2, textY - textH / 2, text, textColor, fontSize);
+            switch (tag.id()) {
+                case tags::ButtonId: {
+                    Rect layout = getRectFromProps(props, {offsetX, offsetY, 150, 40});
+                    elementLayouts_[node->getStableId()] = layout;
+                    
+                    uint32_t bgColor = getColorFromProps(props, keys::backgroundColor, 0x4A90E2FF);
+                    uint32_t borderColor = getColorFromProps(props, keys::borderColor, 0x357ABDFF);
+                    uint32_t textColor = getColorFromProps(props, keys::color, 0xFFFFFFFF);
+                    
+                    fillRect(layout, bgColor);
+                    drawRect(layout, borderColor);
+                    
+                    int textX = layout.x + layout.width / 2;
+                    int textY = layout.y + layout.height / 2;
+                    for (const auto& child : vnode.getChildren()) {
+                        if (child) {
+                            if (child->getType() == VNodeType::Text) {
+                                renderText(*child, props, textX, textY, textColor, 14, true);
+                            } else {
+                                renderVNode(child, layout.x + 10, layout.y + 10);
                             }
-                        } else {
-                            renderVNode(child, layout.x + 10, layout.y + 10);
                         }
                     }
+                    return;
                 }
-                break;
-            }
-            
-            if (tag == "Text") {
-                for (const auto& child : node->getChildren()) {
-                    if (child && child->getType() == VNodeType::Text) {
-                        std::string text = child->getText();
-                        if (!text.empty()) {
-                            uint32_t textColor = getColorFromProps(node->getProps(), "color", 0x000000FF);
-                            int fontSize = 16;
-                            if (node->getProps().has("fontSize")) {
-                                try {
-                                    fontSize = node->getProps().get<int>("fontSize");
-                                } catch (...) {}
-                            }
-                            
-                            int textW, textH;
-                            getTextSize(text, fontSize, textW, textH);
-                            Rect textLayout = {offsetX, offsetY, textW, textH};
-                            
-                            if (node->getProps().has("onClick")) {
-                                elementLayouts_[node->getId()] = textLayout;
+                
+                // Explicit "Text" wrapper elements (elements::Text no longer emits them)
+                case tags::TextId: {
+                    for (const auto& child : vnode.getChildren()) {
+                        if (child && child->getType() == VNodeType::Text) {
+                            Rect textLayout = renderText(*child, props, offsetX, offsetY, 0x000000FF, 16, false);
+                            if (props.has(keys::onClick)) {
+                                elementLayouts_[node->getStableId()] = textLayout;
                             }
-                            
-                            drawText(offsetX, offsetY, text, textColor, fontSize);
+                        } else if (child) {
+                            renderVNode(child, offsetX, offsetY);
                         }
-                    } else if (child) {
-                        renderVNode(child, offsetX, offsetY);
                     }
+                    return;
                 }
-                break;
+                
+                default:
+                    break;
             }
             
-            Rect layout = getRectFromProps(node->getProps(), {offsetX, offsetY, width_ - offsetX, height_ - offsetY});
+            Rect layout = getRectFromProps(props, {offsetX, offsetY, width_ - offsetX, height_ - offsetY});
             if (layout.width <= 0) layout.width = width_ - offsetX;
             if (layout.height <= 0) layout.height = height_ - offsetY;
             
-            if (node->getProps().has("onClick") || tag == "Button" || tag == "View") {
-                elementLayouts_[node->getId()] = layout;
+            if (props.has(keys::onClick) || tag == tags::Button || tag == tags::View) {
+                elementLayouts_[node->getStableId()] = layout;
             }
             
-            uint32_t bgColor = 0x00000000;
-            if (node->getProps().has("backgroundColor")) {
-                bgColor = getColorFromProps(node->getProps(), "backgroundColor", 0x00000000);
-            }
-            uint32_t borderColor = getColorFromProps(node->getProps(), "borderColor", 0x000000FF);
+            uint32_t bgColor = getColorFromProps(props, keys::backgroundColor, 0x00000000);
+            uint32_t borderColor = getColorFromProps(props, keys::borderColor, 0x000000FF);
             
-            if (node->getProps().has("gradient")) {
-                try {
-                    auto gradient = node->getProps().get<std::vector<GradientStop>>("gradient");
-                    std::string directionStr = "horizontal";
-                    if (node->getProps().has("gradientDirection")) {
-                        directionStr = node->getProps().get<std::string>("gradientDirection");
-                    }
-                    GradientDirection dir = GradientDirection::Horizontal;
-                    if (directionStr == "vertical") dir = GradientDirection::Vertical;
-                    else if (directionStr == "radial") dir = GradientDirection::Radial;
-                    
-                    fillRectGradient(layout, gradient, dir);
-                } catch (...) {
-                    if (bgColor != 0x00000000) {
-                        fillRect(layout, bgColor);
-                    }
-                }
-            } else {
-                if (bgColor != 0x00000000) {
-                    fillRect(layout, bgColor);
+            if (const auto* gradient = props.getIf<std::vector<GradientStop>>(keys::gradient)) {
+                GradientDirection dir = GradientDirection::Horizontal;
+                if (const auto* direction = props.getIf<std::string>(keys::gradientDirection)) {
+                    if (*direction == "vertical") dir = GradientDirection::Vertical;
+                    else if (*direction == "radial") dir = GradientDirection::Radial;
                 }
+                fillRectGradient(layout, *gradient, dir);
+            } else if (bgColor != 0x00000000) {
+                fillRect(layout, bgColor);
             }
             
-            if (node->getProps().has("borderWidth")) {
-                try {
-                    int borderWidth = node->getProps().get<int>("borderWidth");
-                    if (borderWidth > 0) {
-                        for (int i = 0; i < borderWidth; i++) {
-                            drawRect(layout.x + i, layout.y + i, 
-                                    layout.width - 2*i, layout.height - 2*i, borderColor);
-                        }
-                    }
-                } catch (...) {}
+            int borderWidth = props.builtins().getOr<BuiltinProps::BorderWidth>(0);
+            for (int i = 0; i < borderWidth; i++) {
+                drawRect(layout.x + i, layout.y + i, 
+                        layout.width - 2*i, layout.height - 2*i, borderColor);
             }
             
             int childOffsetY = offsetY;
-            for (const auto& child : node->getChildren()) {
+            for (const auto& child : vnode.getChildren()) {
                 if (child) {
                     if (child->getType() == VNodeType::Text) {
-                        std::string text = child->getText();
-                        if (!text.empty()) {
-                            uint32_t textColor = getColorFromProps(node->getProps(), "color", 0x000000FF);
-                            int fontSize = 16;
-                            if (node->getProps().has("fontSize")) {
-                                try {
-                                    fontSize = node->getProps().get<int>("fontSize");
-                                } catch (...) {}
-                            }
-                            drawText(layout.x + 10, childOffsetY + 20, text, textColor, fontSize);
-                            int textW, textH;
-                            getTextSize(text, fontSize, textW, textH);
-                            childOffsetY += textH + 5;
+                        if (!child->getText().empty()) {
+                            Rect textLayout = renderText(*child, props, layout.x + 10, childOffsetY + 20, 0x000000FF, 16, false);
+                            childOffsetY += textLayout.height + 5;
                         }
                     } else {
                         renderVNode(child, layout.x + 10, childOffsetY);
@@ -800,23 +734,14 @@ void FramebufferRenderer::renderVNode(VNode::Ptr node, int offsetX, int offsetY)
         }
         
         case VNodeType::Text: {
-            std::string text = node->getText();
-            if (!text.empty()) {
-                uint32_t textColor = getColorFromProps(node->getProps(), "color", 0x000000FF);
-                int fontSize = 16;
-                if (node->getProps().has("fontSize")) {
-                    try {
-                        fontSize = node->getProps().get<int>("fontSize");
-                    } catch (...) {}
-                }
-                drawText(offsetX, offsetY, text, textColor, fontSize);
-            }
+            static const Props noInheritedProps;
+            renderText(vnode, noInheritedProps, offsetX, offsetY, 0x000000FF, 16, false);
             break;
         }
         
         case VNodeType::Component:
         case VNodeType::Fragment: {
-            for (const auto& child : node->getChildren()) {
+            for (const auto& child : vnode.getChildren()) {
                 if (child) {
                     renderVNode(child, offsetX, offsetY);
                 }
@@ -826,20 +751,47 @@ void FramebufferRenderer::renderVNode(VNode::Ptr node, int offsetX, int offsetY)
     }
 }
 
+Rect FramebufferRenderer::renderText(const VNode& node, const Props& inherited, int x, int y,
+                                     uint32_t defaultColor, int defaultFontSize, bool centered) {
+    const std::string& text = node.getText();
+    if (text.empty()) {
+        return {x, y, 0, 0};
+    }
+    
+    const Props& props = node.getProps();
+    uint32_t textColor = getColorFromProps(props, keys::color,
+                                           getColorFromProps(inherited, keys::color, defaultColor));
+    int fontSize = props.builtins().getOr<BuiltinProps::FontSize>(
+        inherited.builtins().getOr<BuiltinProps::FontSize>(defaultFontSize));
+    
+    int textW, textH;
+    getTextSize(text, fontSize, textW, textH);
+    Rect layout = {centered ? x - textW / 2 : x, centered ? y - textH / 2 : y, textW, textH};
+    layout = getRectFromProps(props, layout);
+    
+    if (props.has(keys::onClick)) {
+        elementLayouts_[node.getStableId()] = layout;
+    }
+    drawText(layout.x, layout.y, text, textColor, fontSize);
+    return layout;
+}
+
 void FramebufferRenderer::clearLayoutCache() {
     elementLayouts_.clear();
 }
 
 void FramebufferRenderer::render(VNode::Ptr root) {
     if (!root) return;
+    root->assignStableIds();
     clearLayoutCache();
     renderVNode(root, 0, 0);
 }
 
 VNode::Ptr FramebufferRenderer::findElementAtRecursive(int x, int y, VNode::Ptr node) {
     if (!node) return nullptr;
+    const VNode& vnode = *node;
     
-    auto it = elementLayouts_.find(node->getId());
+    auto it = elementLayouts_.find(node->getStableId());
     if (it != elementLayouts_.end()) {
         const Rect& rect = it->second;
         
@@ -847,15 +799,12 @@ VNode::Ptr FramebufferRenderer::findElementAtRecursive(int x, int y, VNode::Ptr
             y >= rect.y && y < rect.y + rect.height) {
             
             VNode::Ptr bestChild = nullptr;
-            for (const auto& child : node->getChildren()) {
+            for (const auto& child : vnode.getChildren()) {
                 if (child) {
                     auto found = findElementAtRecursive(x, y, child);
                     if (found) {
-                        if (found->getType() == VNodeType::Element) {
-                            const std::string& tag = found->getTag();
-                            if (tag == "Button" || found->getProps().has("onClick")) {
-                                return found;
-                            }
+                        if (found->getTagId() == tags::Button || std::as_const(*found).getProps().has(keys::onClick)) {
+                            return found;
                         }
                         if (!bestChild) bestChild = found;
                     }
@@ -864,11 +813,8 @@ VNode::Ptr FramebufferRenderer::findElementAtRecursive(int x, int y, VNode::Ptr
             
             if (bestChild) return bestChild;
             
-            if (node->getType() == VNodeType::Element) {
-                const std::string& tag = node->getTag();
-                if (tag == "Button" || node->getProps().has("onClick")) {
-                    return node;
-                }
+            if (vnode.getTagId() == tags::Button || vnode.getProps().has(keys::onClick)) {
+                return node;
             }
         }
     }
@@ -878,6 +824,9 @@ VNode::Ptr FramebufferRenderer::findElementAtRecursive(int x, int y, VNode::Ptr
 
 VNode::Ptr FramebufferRenderer::findElementAt(int x, int y, VNode::Ptr root) {
     if (!root) return nullptr;
+    // Layouts are keyed by stable id, so a newer tree than the one last
+    // rendered still hits the entries of its unchanged nodes. render()
+    // assigned the ids; an unrendered tree derives them on demand.
     return findElementAtRecursive(x, y, root);
 }
 
@@ -887,24 +836,25 @@ bool FramebufferRenderer::handleClick(int x, int y, VNode::Ptr root) {
         return false;
     }
     
-    if (clicked->getType() == VNodeType::Element) {
-        const Props& props = clicked->getProps();
-        if (props.has("onClick")) {
-            try {
-                auto typeIndex = props.getType("onClick");
-                if (typeIndex && *typeIndex == std::type_index(typeid(std::function<void()>))) {
-                    auto onClick = props.get<std::function<void()>>("onClick");
-                    if (onClick) {
-                        onClick();
-                        return true;
-                    }
-                }
-            } catch (const std::exception& e) {
-                std::cerr << "Error calling onClick handler: " << e.what() << std::endl;
-            } catch (...) {
-                std::cerr << "Unknown error calling onClick handler" << std::endl;
-            }
+    // Elements and text nodes can both carry onClick, either as a handle
+    // into the handler table or as a function. The function is copied
+    // first: the handler may replace the node's props, and with them the
+    // std::function it is running from.
+    const Props& props = std::as_const(*clicked).getProps();
+    try {
+        if (const auto* handle = props.getIf<EventHandle>(keys::onClick)) {
+            return HandlerTable::global().invoke(*handle);
+        }
+        const auto* onClick = props.getIf<std::function<void()>>(keys::onClick);
+        if (onClick && *onClick) {
+            std::function<void()> handler = *onClick;
+            handler();
+            return true;
         }
+    } catch (const std::exception& e) {
+        std::cerr << "Error calling onClick handler: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Unknown error calling onClick handler" << std::endl;
     }
     
     return false;
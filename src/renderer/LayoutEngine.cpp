@@ -1,32 +1,135 @@
 #include "reactpp/renderer/LayoutEngine.hpp"
+#include <vector>
 
 namespace reactpp {
 namespace renderer {
 
+namespace {
+
+// Spacing used by the renderers when stacking children
+constexpr int ChildIndent = 10;
+constexpr int ElementAdvance = 50;
+constexpr int TextAdvance = 5;
+constexpr int TextOffsetY = 20;  // Text stacked in a View is drawn this far below the cursor
+
+// Rough text extent; renderers measure with the actual font
+Rect estimateText(std::string_view text, int fontSize, int x, int y) {
+    int width = static_cast<int>(text.size()) * fontSize * 3 / 5;
+    int height = fontSize * 5 / 4;
+    return {x, y, width, height};
+}
+
+int orDefault(int value, int fallback) {
+    return value == LayoutSpec::Auto ? fallback : value;
+}
+
+} // namespace
+
 LayoutEngine::LayoutEngine() {
 }
 
 void LayoutEngine::calculateLayout(VNode::Ptr root, int containerWidth, int containerHeight) {
-    // TODO: Implement flexbox layout algorithm
-    (void)root;
-    (void)containerWidth;
-    (void)containerHeight;
+    layouts_.clear();
+    table_.clear();
+    if (!root) return;
+    
+    table_.build(*root);
+    calculateLayout(table_, containerWidth, containerHeight);
+    
+    const auto& ids = table_.stableIds();
+    const auto& rects = table_.layouts();
+    layouts_.reserve(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i) {
+        layouts_[ids[i]] = rects[i];
+    }
+}
+
+void LayoutEngine::calculateLayout(NodeTable& table, int containerWidth, int containerHeight) {
+    // Where each node places its next child. Parents precede their children
+    // in the table, so a single forward pass sees every cursor it needs.
+    std::vector<Point> cursors(table.size());
+    std::vector<bool> stacking(table.size(), false);
+    
+    const auto& types = table.types();
+    const auto& tagIds = table.tags();
+    const auto& parents = table.parents();
+    const auto& specs = table.specs();
+    const auto& styles = table.styles();
+    const auto& texts = table.texts();
+    auto& rects = table.layouts();
+    
+    for (size_t i = 0; i < table.size(); ++i) {
+        NodeIndex parent = parents[i];
+        Point origin = parent == InvalidNode ? Point{0, 0} : cursors[parent];
+        const LayoutSpec& spec = specs[i];
+        Rect rect{origin.x, origin.y, 0, 0};
+        
+        switch (types[i]) {
+            case VNodeType::Element:
+                if (tagIds[i] == tags::Button) {
+                    rect = {orDefault(spec.x, origin.x), orDefault(spec.y, origin.y),
+                            orDefault(spec.width, 150), orDefault(spec.height, 40)};
+                    cursors[i] = {rect.x + ChildIndent, rect.y + ChildIndent};
+                } else if (tagIds[i] == tags::Text) {
+                    // Sized by its text children; they don't advance anything
+                    cursors[i] = origin;
+                } else {
+                    rect = {orDefault(spec.x, origin.x), orDefault(spec.y, origin.y),
+                            orDefault(spec.width, containerWidth - origin.x),
+                            orDefault(spec.height, containerHeight - origin.y)};
+                    if (rect.width <= 0) rect.width = containerWidth - origin.x;
+                    if (rect.height <= 0) rect.height = containerHeight - origin.y;
+                    cursors[i] = {rect.x + ChildIndent, origin.y};
+                    stacking[i] = true;
+                }
+                break;
+            
+            case VNodeType::Text: {
+                // Placed where the renderers draw it: centered in a Button,
+                // offset below the cursor in a View
+                bool inElement = parent != InvalidNode && types[parent] == VNodeType::Element;
+                rect = texts[i].empty() ? Rect{0, 0, 0, 0} : estimateText(texts[i], styles[i].fontSize, 0, 0);
+                if (inElement && tagIds[parent] == tags::Button) {
+                    const Rect& button = rects[parent];
+                    origin = {button.x + button.width / 2 - rect.width / 2,
+                              button.y + button.height / 2 - rect.height / 2};
+                } else if (parent != InvalidNode && stacking[parent]) {
+                    origin.y += TextOffsetY;
+                }
+                rect = {orDefault(spec.x, origin.x), orDefault(spec.y, origin.y),
+                        orDefault(spec.width, rect.width), orDefault(spec.height, rect.height)};
+                if (inElement && tagIds[parent] == tags::Text) {
+                    rects[parent] = rect;
+                }
+                break;
+            }
+            
+            case VNodeType::Component:
+            case VNodeType::Fragment:
+                cursors[i] = origin;
+                break;
+        }
+        rects[i] = rect;
+        
+        // Advance the parent's cursor past this child; the renderers skip
+        // empty text
+        if (parent != InvalidNode && stacking[parent]) {
+            if (types[i] != VNodeType::Text) {
+                cursors[parent].y += ElementAdvance;
+            } else if (!texts[i].empty()) {
+                cursors[parent].y += rect.height + TextAdvance;
+            }
+        }
+    }
 }
 
-Rect LayoutEngine::getLayout(uint64_t nodeId) const {
-    auto it = layouts_.find(nodeId);
+Rect LayoutEngine::getLayout(StableId stableId) const {
+    auto it = layouts_.find(stableId);
     if (it != layouts_.end()) {
         return it->second;
     }
     return {0, 0, 0, 0};
 }
 
-void LayoutEngine::layoutNode(VNode::Ptr node, int availableWidth, int availableHeight) {
-    // TODO: Implement node layout calculation
-    (void)node;
-    (void)availableWidth;
-    (void)availableHeight;
-}
-
 } // namespace renderer
 } // namespace reactpp
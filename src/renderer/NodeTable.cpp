@@ -0,0 +1,157 @@
+#include "reactpp/renderer/NodeTable.hpp"
+#include <string>
+#include <typeindex>
+
+namespace reactpp {
+namespace renderer {
+
+namespace {
+
+// Accepts uint32_t RGBA values and "#RRGGBB" / "#RRGGBBAA" strings,
+// like the renderers do
+uint32_t readColor(const Props& props, PropKey key, uint32_t fallback) {
+    if (const auto* value = props.getIf<uint32_t>(key)) {
+        return *value;
+    }
+    if (const auto* hex = props.getIf<std::string>(key)) {
+        if (hex->size() < 7 || (*hex)[0] != '#') {
+            return fallback;
+        }
+        uint32_t color = 0;
+        for (size_t i = 1; i < hex->size() && i < 9; i++) {
+            char c = (*hex)[i];
+            uint32_t val = 0;
+            if (c >= '0' && c <= '9') val = c - '0';
+            else if (c >= 'A' && c <= 'F') val = c - 'A' + 10;
+            else if (c >= 'a' && c <= 'f') val = c - 'a' + 10;
+            else continue;
+            color = (color << 4) | val;
+        }
+        if (hex->size() == 7) {
+            color = (color << 8) | 0xFF;
+        }
+        return color;
+    }
+    return fallback;
+}
+
+NodeStyle resolveStyle(TagId tag, const Props& props) {
+    NodeStyle style;
+    if (tag == tags::Button) {
+        // Matches the renderers' built-in button look
+        style.backgroundColor = 0x4A90E2FF;
+        style.borderColor = 0x357ABDFF;
+        style.color = 0xFFFFFFFF;
+        style.fontSize = 14;
+    }
+    style.backgroundColor = readColor(props, keys::backgroundColor, style.backgroundColor);
+    style.borderColor = readColor(props, keys::borderColor, style.borderColor);
+    style.color = readColor(props, keys::color, style.color);
+    style.fontSize = props.builtins().getOr<BuiltinProps::FontSize>(style.fontSize);
+    style.borderWidth = props.builtins().getOr<BuiltinProps::BorderWidth>(style.borderWidth);
+    return style;
+}
+
+} // namespace
+
+void NodeTable::build(const VNode& root) {
+    clear();
+
+    struct Open {
+        NodeIndex row;
+        ChildStableIds children;
+    };
+    SmallVector<Open, 32> stack;
+    root.visitDepthFirst(
+        [&](const VNode& node) {
+            NodeIndex parent = InvalidNode;
+            StableId stableId;
+            if (stack.empty()) {
+                stableId = node.getStableId();
+            } else {
+                parent = stack.back().row;
+                stableId = stack.back().children.next(node);
+            }
+            stack.push_back({append(node, parent, stableId), ChildStableIds(stableId)});
+        },
+        [&](const VNode&) {
+            subtreeEnds_[stack.back().row] = static_cast<NodeIndex>(size());
+            stack.pop_back();
+        });
+
+    lastChildren_.clear();
+}
+
+void NodeTable::clear() {
+    types_.clear();
+    tags_.clear();
+    vnodeIds_.clear();
+    stableIds_.clear();
+    texts_.clear();
+    parents_.clear();
+    firstChildren_.clear();
+    nextSiblings_.clear();
+    subtreeEnds_.clear();
+    specs_.clear();
+    styles_.clear();
+    layouts_.clear();
+    sources_.clear();
+    lastChildren_.clear();
+}
+
+NodeHandle NodeTable::find(uint64_t vnodeId) const {
+    for (size_t i = 0; i < vnodeIds_.size(); ++i) {
+        if (vnodeIds_[i] == vnodeId) {
+            return handle(static_cast<NodeIndex>(i));
+        }
+    }
+    return NodeHandle();
+}
+
+NodeIndex NodeTable::append(const VNode& node, NodeIndex parent, StableId stableId) {
+    auto index = static_cast<NodeIndex>(size());
+    const Props& props = node.getProps();
+
+    types_.push_back(node.getType());
+    tags_.push_back(node.getTagId());
+    vnodeIds_.push_back(node.getId());
+    stableIds_.push_back(stableId);
+    texts_.push_back(node.getText());
+    parents_.push_back(parent);
+    firstChildren_.push_back(InvalidNode);
+    nextSiblings_.push_back(InvalidNode);
+    subtreeEnds_.push_back(index + 1);
+    lastChildren_.push_back(InvalidNode);
+    sources_.push_back(&node);
+    layouts_.push_back({0, 0, 0, 0});
+
+    const BuiltinProps& fields = props.builtins();
+    LayoutSpec spec;
+    spec.x = fields.getOr<BuiltinProps::X>(LayoutSpec::Auto);
+    spec.y = fields.getOr<BuiltinProps::Y>(LayoutSpec::Auto);
+    spec.width = fields.getOr<BuiltinProps::Width>(LayoutSpec::Auto);
+    spec.height = fields.getOr<BuiltinProps::Height>(LayoutSpec::Auto);
+    specs_.push_back(spec);
+
+    if (node.getType() == VNodeType::Text && parent != InvalidNode) {
+        NodeStyle style = styles_[parent];
+        style.color = readColor(props, keys::color, style.color);
+        style.fontSize = fields.getOr<BuiltinProps::FontSize>(style.fontSize);
+        styles_.push_back(style);
+    } else {
+        styles_.push_back(resolveStyle(node.getTagId(), props));
+    }
+
+    if (parent != InvalidNode) {
+        if (lastChildren_[parent] == InvalidNode) {
+            firstChildren_[parent] = index;
+        } else {
+            nextSiblings_[lastChildren_[parent]] = index;
+        }
+        lastChildren_[parent] = index;
+    }
+    return index;
+}
+
+} // namespace renderer
+} // namespace reactpp
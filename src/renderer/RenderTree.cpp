@@ -1,30 +1,126 @@
 #include "reactpp/renderer/RenderTree.hpp"
+#include <algorithm>
+#include <unordered_set>
 
 namespace reactpp {
 namespace renderer {
 
+namespace {
+
+bool sameRect(const Rect& a, const Rect& b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+} // namespace
+
 RenderTreeNode::RenderTreeNode(VNode::Ptr vnode)
     : vnode(vnode), needsRepaint(false) {
     layout = {0, 0, 0, 0};
 }
 
-RenderTree::RenderTree() {
+RenderTree::RenderTree(int viewportWidth, int viewportHeight)
+    : viewportWidth_(viewportWidth), viewportHeight_(viewportHeight) {
+}
+
+void RenderTree::setViewportSize(int width, int height) {
+    viewportWidth_ = width;
+    viewportHeight_ = height;
 }
 
 void RenderTree::update(VNode::Ptr root) {
-    // TODO: Update render tree from VNode tree
-    (void)root;
+    if (!root) {
+        nodes_.clear();
+        return;
+    }
+    
+    layoutEngine_.calculateLayout(root, viewportWidth_, viewportHeight_);
+    styleResolver_.computeStyles(root);
+    
+    // The layout table already holds every node with its stable id
+    const NodeTable& table = layoutEngine_.getNodeTable();
+    const auto& stableIds = table.stableIds();
+    const auto& layouts = table.layouts();
+    
+    std::unordered_set<StableId> seen;
+    seen.reserve(table.size());
+    for (NodeIndex i = 0; i < table.size(); ++i) {
+        StableId stableId = stableIds[i];
+        seen.insert(stableId);
+        
+        const VNode& vnode = table.vnode(i);
+        auto owner = std::const_pointer_cast<VNode>(vnode.shared_from_this());
+        
+        const Props* styles = styleResolver_.getComputedStyles(stableId);
+        auto& node = nodes_[stableId];
+        if (vnode.isHoisted() && skipHoisted(table, i, node.get(), styles)) {
+            // Same nodes, styles and layout as last time: nothing to repaint
+            for (NodeIndex end = table.subtreeEnd(i); i + 1 < end; ++i) {
+                seen.insert(stableIds[i + 1]);
+            }
+            continue;
+        }
+        if (!node) {
+            node = std::make_shared<RenderTreeNode>(owner);
+            node->layout = layouts[i];
+            node->computedStyles = styles ? *styles : Props();
+            node->needsRepaint = true;
+            continue;
+        }
+        
+        bool changed = !sameRect(node->layout, layouts[i]) ||
+                       (styles && node->computedStyles != *styles) ||
+                       node->vnode->getText() != vnode.getText();
+        node->vnode = owner;
+        node->layout = layouts[i];
+        if (changed) {
+            node->computedStyles = styles ? *styles : Props();
+            node->needsRepaint = true;
+        }
+    }
+    
+    for (auto it = nodes_.begin(); it != nodes_.end();) {
+        if (!seen.count(it->first)) {
+            it = nodes_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = hoisted_.begin(); it != hoisted_.end();) {
+        if (!seen.count(it->first)) {
+            it = hoisted_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool RenderTree::skipHoisted(const NodeTable& table, NodeIndex index,
+                             const RenderTreeNode* node, const Props* styles) {
+    const VNode& vnode = table.vnode(index);
+    const Rect* first = table.layouts().data() + index;
+    const Rect* last = table.layouts().data() + table.subtreeEnd(index);
+    
+    HoistedSubtree& subtree = hoisted_[table.stableIds()[index]];
+    bool same = node && subtree.source == &vnode && subtree.hash == vnode.structuralHash() &&
+                (!styles || node->computedStyles == *styles) &&
+                std::equal(first, last, subtree.layouts.begin(), subtree.layouts.end(), sameRect);
+    if (!same) {
+        subtree.source = &vnode;
+        subtree.hash = vnode.structuralHash();
+        subtree.layouts.assign(first, last);
+    }
+    return same;
 }
 
-void RenderTree::markDirty(uint64_t nodeId) {
-    auto it = nodes_.find(nodeId);
+void RenderTree::markDirty(StableId stableId) {
+    auto it = nodes_.find(stableId);
     if (it != nodes_.end()) {
         it->second->needsRepaint = true;
     }
 }
 
-std::shared_ptr<RenderTreeNode> RenderTree::getNode(uint64_t nodeId) const {
-    auto it = nodes_.find(nodeId);
+std::shared_ptr<RenderTreeNode> RenderTree::getNode(StableId stableId) const {
+    auto it = nodes_.find(stableId);
     if (it != nodes_.end()) {
         return it->second;
     }
@@ -1,20 +1,168 @@
 #include "reactpp/renderer/StyleResolver.hpp"
+#include "reactpp/core/Hash.hpp"
+#include "reactpp/core/SmallVector.hpp"
 
 namespace reactpp {
 namespace renderer {
 
-StyleResolver::StyleResolver() {
+namespace {
+
+const PropKey StyleKeys[] = {
+    keys::backgroundColor, keys::borderColor, keys::color, keys::fontSize,
+    keys::borderWidth, keys::gradient, keys::gradientDirection
+};
+
+// Styles children pick up from their parent
+const PropKey InheritedKeys[] = {keys::color, keys::fontSize};
+
+} // namespace
+
+StyleResolver::StyleResolver() : generation_(0), reused_(0), skipped_(0) {
+    defaultStyles_.set(keys::color, 0x000000FFu);
+    defaultStyles_.set(keys::fontSize, 16);
+}
+
+Props StyleResolver::compute(const Props& own, const Props* inherited) const {
+    Props styles = defaultStyles_;
+    if (inherited) {
+        for (PropKey key : InheritedKeys) {
+            styles.copyFrom(*inherited, key);
+        }
+    }
+    for (PropKey key : StyleKeys) {
+        styles.copyFrom(own, key);
+    }
+    return styles;
 }
 
 Props StyleResolver::resolveStyles(VNode::Ptr node) {
-    // TODO: Implement style resolution
-    (void)node;
-    return Props();
+    if (!node) {
+        return defaultStyles_;
+    }
+    
+    const Props* inherited = nullptr;
+    uint64_t inheritedHash = 0;
+    if (auto parent = node->getParent().lock()) {
+        auto it = computedStyles_.find(parent->getStableId());
+        if (it != computedStyles_.end()) {
+            inherited = &it->second.styles;
+            inheritedHash = it->second.stylesHash;
+        }
+    }
+    
+    auto it = computedStyles_.find(node->getStableId());
+    if (it != computedStyles_.end() &&
+        it->second.inputHash == hashCombine(node->getProps().visualHash(), inheritedHash)) {
+        return it->second.styles;
+    }
+    return compute(node->getProps(), inherited);
 }
 
 void StyleResolver::computeStyles(VNode::Ptr node) {
-    // TODO: Implement style computation
-    (void)node;
+    ++generation_;
+    reused_ = 0;
+    skipped_ = 0;
+    if (!node) {
+        computedStyles_.clear();
+        return;
+    }
+    
+    // Stable ids are derived on the way down, like NodeTable does. scope is
+    // the innermost hoisted subtree the node belongs to.
+    struct Open {
+        const Entry* entry;
+        ChildStableIds children;
+        StableId scope;
+    };
+    SmallVector<Open, 32> stack;
+    node->visitDepthFirst(
+        [&](const VNode& current) {
+            StableId stableId;
+            const Entry* parent = nullptr;
+            StableId scope = 0;
+            if (stack.empty()) {
+                stableId = current.getStableId();
+            } else {
+                Open& top = stack.back();
+                stableId = top.children.next(current);
+                parent = top.entry;
+                scope = top.scope;
+            }
+            
+            uint64_t inputHash = hashCombine(current.getProps().visualHash(), parent ? parent->stylesHash : 0);
+            Entry& entry = computedStyles_[stableId];
+            bool unchanged = entry.generation != 0 && entry.inputHash == inputHash;
+            entry.generation = generation_;
+            
+            if (current.isHoisted()) {
+                // The same hoisted subtree under the same inherited styles
+                // resolves exactly as before: keep its entries untouched
+                entry.outerScope = scope;
+                if (unchanged && entry.hoisted == &current &&
+                    entry.hoistedHash == current.structuralHash()) {
+                    entry.skipped = generation_;
+                    ++reused_;
+                    ++skipped_;
+                    stack.push_back({&entry, ChildStableIds(stableId), stableId});
+                    return VisitResult::SkipChildren;
+                }
+                entry.hoisted = &current;
+                entry.hoistedHash = current.structuralHash();
+                scope = stableId;
+            } else {
+                entry.hoisted = nullptr;
+            }
+            entry.scope = scope;
+            
+            if (unchanged) {
+                ++reused_;
+            } else {
+                entry.styles = compute(current.getProps(), parent ? &parent->styles : nullptr);
+                entry.inputHash = inputHash;
+                entry.stylesHash = entry.styles.hash();
+            }
+            stack.push_back({&entry, ChildStableIds(stableId), scope});
+            return VisitResult::Continue;
+        },
+        [&](const VNode&) {
+            stack.pop_back();
+        });
+    
+    // Entries inside a skipped subtree were not visited but are still in
+    // the tree. Retained entries only chain through retained scopes, so
+    // erasing while walking is safe.
+    auto retained = [this](const Entry& entry) {
+        if (entry.generation == generation_) {
+            return true;
+        }
+        for (StableId scope = entry.scope; scope != 0;) {
+            auto it = computedStyles_.find(scope);
+            if (it == computedStyles_.end()) {
+                return false;
+            }
+            const Entry& root = it->second;
+            if (root.skipped == generation_) {
+                return true;
+            }
+            if (root.generation == generation_) {
+                return false;
+            }
+            scope = root.outerScope;
+        }
+        return false;
+    };
+    for (auto it = computedStyles_.begin(); it != computedStyles_.end();) {
+        if (!retained(it->second)) {
+            it = computedStyles_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const Props* StyleResolver::getComputedStyles(StableId stableId) const {
+    auto it = computedStyles_.find(stableId);
+    return it != computedStyles_.end() ? &it->second.styles : nullptr;
 }
 
 } // namespace renderer
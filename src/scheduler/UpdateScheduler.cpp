@@ -2,14 +2,14 @@
 
 namespace reactpp {
 
-UpdateScheduler::UpdateScheduler() : batching_(false) {
+UpdateScheduler::UpdateScheduler() : batching_(false), nextTimestamp_(0) {
 }
 
 void UpdateScheduler::scheduleUpdate(FiberNode::Ptr fiber, Priority priority) {
     Update update;
     update.fiber = fiber;
     update.priority = priority;
-    update.timestamp = 0; // TODO: Get actual timestamp
+    update.timestamp = nextTimestamp_++;
     updateQueue_.push(update);
 }
 
@@ -21,6 +21,15 @@ void UpdateScheduler::processUpdates() {
     }
 }
 
+FiberNode::Ptr UpdateScheduler::takeUpdate() {
+    if (updateQueue_.empty()) {
+        return nullptr;
+    }
+    FiberNode::Ptr fiber = updateQueue_.top().fiber;
+    updateQueue_.pop();
+    return fiber;
+}
+
 void UpdateScheduler::batchUpdates(std::function<void()> fn) {
     batching_ = true;
     fn();
@@ -1,29 +1,86 @@
 #include "reactpp/scheduler/WorkLoop.hpp"
+#include <chrono>
+#include <utility>
 
 namespace reactpp {
 
-WorkLoop::WorkLoop(std::shared_ptr<UpdateScheduler> scheduler)
-    : scheduler_(scheduler), running_(false), frameStartTime_(0) {
+namespace {
+
+uint64_t steadyMilliseconds() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+WorkLoop::WorkLoop(std::shared_ptr<UpdateScheduler> scheduler, Clock clock)
+    : scheduler_(std::move(scheduler)),
+      clock_(clock ? std::move(clock) : Clock(steadyMilliseconds)),
+      running_(false), frameStartTime_(0), budgetMs_(FRAME_BUDGET_MS) {
 }
 
-void WorkLoop::run() {
-    running_ = true;
-    // TODO: Implement main loop
+void WorkLoop::schedule(VNode::Ptr next, Priority priority) {
+    scheduler_->scheduleUpdate(FiberNode::create(std::move(next)), priority);
+}
+
+bool WorkLoop::run() {
+    frameStartTime_ = clock_();
+    if (!running_ && !startNext()) {
+        return false;
+    }
+
+    // At least one unit per tick, so a tiny budget still makes progress
+    do {
+        if (!work()) {
+            commitRoot();
+            if (shouldYield() || !startNext()) {
+                break;
+            }
+        }
+    } while (!shouldYield());
+    return running_ || scheduler_->hasPendingUpdates();
 }
 
 void WorkLoop::stop() {
     running_ = false;
+    workRoot_.reset();
+    reconciler_.begin(nullptr, nullptr);  // Release the partial tree
 }
 
-bool WorkLoop::work(FiberNode::Ptr fiber) {
-    // TODO: Implement work processing
-    (void)fiber;
-    return false;
+bool WorkLoop::work() {
+    return running_ && reconciler_.performUnitOfWork();
 }
 
 bool WorkLoop::shouldYield() const {
-    // TODO: Check if time budget exceeded
+    return clock_() - frameStartTime_ >= budgetMs_;
+}
+
+bool WorkLoop::startNext() {
+    while (FiberNode::Ptr update = scheduler_->takeUpdate()) {
+        // Diffing against the committed fibers recycles their alternates
+        workRoot_ = reconciler_.begin(update->alternate ? update->alternate : committed_, update->vnode);
+        if (!workRoot_ || workRoot_->effectTag == EffectTag::Deletion) {
+            // Nothing to render; deletions have no work to slice
+            commitRoot();
+            continue;
+        }
+        running_ = true;
+        return true;
+    }
     return false;
 }
 
+void WorkLoop::commitRoot() {
+    running_ = false;
+    FiberNode::Ptr root = std::move(workRoot_);
+    if (!root) {
+        return;
+    }
+    committed_ = root->effectTag == EffectTag::Deletion ? nullptr : root;
+    reconciler_.commit();
+    if (commit_) {
+        commit_(root);
+    }
+}
+
 } // namespace reactpp
@@ -2,6 +2,8 @@
 #include "reactpp/core/Component.hpp"
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/FrameArena.hpp"
+#include <functional>
 
 using namespace reactpp;
 
@@ -67,3 +69,49 @@ TEST(ComponentTest, ComponentId) {
     EXPECT_NE(component1->getId(), component2->getId());
 }
 
+
+TEST(ComponentTest, HoistsStaticSubtrees) {
+    TestComponent component;
+    int builds = 0;
+    auto header = [&builds]() {
+        ++builds;
+        return VNode::createElement("View", Props(), VNode::createText("Header"));
+    };
+    
+    auto first = component.hoisted(0, header);
+    auto second = component.hoisted(0, header);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(builds, 1);
+    EXPECT_TRUE(first->isHoisted());
+    
+    // Subtrees with handlers are dynamic and built every time
+    auto button = [&builds]() {
+        ++builds;
+        Props props;
+        props.set(keys::onClick, std::function<void()>([] {}));
+        return VNode::createElement("Button", props);
+    };
+    auto a = component.hoisted(1, button);
+    auto b = component.hoisted(1, button);
+    EXPECT_NE(a, b);
+    EXPECT_FALSE(a->isHoisted());
+    EXPECT_EQ(builds, 3);
+}
+
+TEST(ComponentTest, HoistedSubtreesOutliveArenaFrames) {
+    TestComponent component;
+    FrameArena arena;
+    VNode::Ptr previous;
+    VNode::Ptr hoisted;
+    for (int frame = 0; frame < 4; ++frame) {
+        // Throws if a node from two frames ago is still alive
+        ASSERT_NO_THROW(arena.beginFrame());
+        FrameArena::Scope scope(arena);
+        auto label = component.hoisted(0, [] { return VNode::createText("Increment"); });
+        if (hoisted) {
+            EXPECT_EQ(label, hoisted);
+        }
+        hoisted = label;
+        previous = VNode::createElement("Button", Props(), label);
+    }
+}
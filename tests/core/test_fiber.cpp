@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "reactpp/core/FiberNode.hpp"
+#include "reactpp/core/FiberPool.hpp"
 #include "reactpp/core/VNode.hpp"
+#include <vector>
 
 using namespace reactpp;
 
@@ -21,3 +23,43 @@ TEST(FiberNodeTest, EffectTag) {
     EXPECT_EQ(fiber->effectTag, EffectTag::Placement);
 }
 
+
+TEST(FiberNodeTest, ResetClearsLinksAndEffects) {
+    auto parent = FiberNode::create(VNode::createElement("div"));
+    auto child = FiberNode::create(VNode::createText("a"));
+    parent->appendChild(child);
+    parent->alternate = FiberNode::create(nullptr);
+    parent->markForUpdate(EffectTag::Update);
+    child->markForUpdate(EffectTag::Placement);
+    parent->addToEffectList(child);
+
+    Props props;
+    props.set(keys::width, 10);
+    auto vnode = VNode::createElement("span", props);
+    parent->reset(vnode);
+    EXPECT_EQ(parent->vnode, vnode);
+    EXPECT_EQ(parent->child, nullptr);
+    EXPECT_EQ(parent->alternate, nullptr);
+    EXPECT_EQ(parent->effectTag, EffectTag::None);
+    EXPECT_TRUE(parent->effectList.empty());
+    EXPECT_EQ(parent->memoizedProps.get<int>(keys::width), 10);
+}
+
+TEST(FiberPoolTest, ReleasedFibersAreReused) {
+    auto& pool = FiberPool::global();
+    FiberNode::create(nullptr);  // Sizes the pool
+    size_t allocated = pool.allocated();
+    {
+        std::vector<FiberNode::Ptr> fibers;
+        for (int i = 0; i < 10; ++i) {
+            fibers.push_back(FiberNode::create(VNode::createText("x")));
+        }
+    }
+    EXPECT_GE(pool.available(), 10u);
+    size_t grown = pool.allocated();
+    EXPECT_LE(grown, allocated + 10);
+    for (int i = 0; i < 10; ++i) {
+        auto fiber = FiberNode::create(nullptr);
+    }
+    EXPECT_EQ(pool.allocated(), grown);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "reactpp/core/FrameArena.hpp"
+#include "reactpp/core/VNode.hpp"
+
+using namespace reactpp;
+
+TEST(FrameArenaTest, NoArenaByDefault) {
+    EXPECT_EQ(FrameArena::current(), nullptr);
+    
+    FrameArena arena;
+    {
+        FrameArena::Scope scope(arena);
+        EXPECT_EQ(FrameArena::current(), &arena);
+    }
+    EXPECT_EQ(FrameArena::current(), nullptr);
+}
+
+TEST(FrameArenaTest, VNodesAllocatedFromArena) {
+    FrameArena arena;
+    VNode::Ptr root;
+    {
+        FrameArena::Scope scope(arena);
+        root = VNode::createElement("View", Props(), {
+            VNode::createText("a"),
+            VNode::createText("b")
+        });
+    }
+    
+    EXPECT_GT(arena.bytesUsed(), 0u);
+    EXPECT_GT(arena.liveAllocations(), 0u);
+    ASSERT_EQ(root->getChildren().size(), 2u);
+    EXPECT_EQ(root->getChildren()[1]->getText(), "b");
+    EXPECT_EQ(root->getChildren()[0]->getParent().lock(), root);
+    
+    root.reset();
+    EXPECT_EQ(arena.liveAllocations(), 0u);
+}
+
+TEST(FrameArenaTest, PropsStorageAllocatedFromArena) {
+    FrameArena arena;
+    {
+        FrameArena::Scope scope(arena);
+        Props props;
+        props.set(keys::width, 100);
+        EXPECT_EQ(arena.liveAllocations(), 1u);
+        
+        // A write to a shared block clones it into the arena too
+        Props copy = props;
+        copy.set(keys::height, 20);
+        EXPECT_EQ(arena.liveAllocations(), 2u);
+    }
+    EXPECT_EQ(arena.liveAllocations(), 0u);
+}
+
+TEST(FrameArenaTest, RecyclesFrameBeforePrevious) {
+    FrameArena arena(1024);
+    VNode::Ptr current;
+    
+    for (int frame = 0; frame < 5; ++frame) {
+        arena.beginFrame();
+        FrameArena::Scope scope(arena);
+        // Previous frame is still referenced here, as it would be for diffing
+        current = VNode::createElement("View", Props(), {VNode::createText(std::to_string(frame))});
+    }
+    
+    EXPECT_EQ(current->getChildren()[0]->getText(), "4");
+    size_t reserved = arena.bytesReserved();
+    
+    // Steady state reuses the same blocks
+    for (int frame = 0; frame < 5; ++frame) {
+        arena.beginFrame();
+        FrameArena::Scope scope(arena);
+        current = VNode::createElement("View", Props(), {VNode::createText("x")});
+    }
+    EXPECT_EQ(arena.bytesReserved(), reserved);
+}
+
+TEST(FrameArenaTest, ThrowsWhenStaleFrameIsAlive) {
+    FrameArena arena;
+    VNode::Ptr stale;
+    {
+        FrameArena::Scope scope(arena);
+        stale = VNode::createText("stale");
+    }
+    
+    arena.beginFrame();
+    EXPECT_THROW(arena.beginFrame(), std::runtime_error);
+    
+    stale.reset();
+    EXPECT_NO_THROW(arena.beginFrame());
+}
+
+TEST(FrameArenaDeathTest, AbortsWhenDestroyedWithLiveAllocations) {
+    EXPECT_DEATH({
+        VNode::Ptr survivor;
+        FrameArena arena;
+        FrameArena::Scope scope(arena);
+        survivor = VNode::createText("survivor");
+    }, "still alive");
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "reactpp/core/Component.hpp"
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/core/Props.hpp"
+#include <string>
+
+using namespace reactpp;
+
+TEST(HandlerTableTest, InvokesBySignature) {
+    HandlerTable table;
+    int clicks = 0;
+    std::string text;
+    EventHandle click = table.add([&clicks]() { ++clicks; });
+    EventHandle change = table.add([&text](const std::string& value) { text = value; });
+
+    EXPECT_TRUE(table.invoke(click));
+    EXPECT_TRUE(table.invoke(change, "hello"));
+    EXPECT_EQ(clicks, 1);
+    EXPECT_EQ(text, "hello");
+
+    // Wrong signature and the empty handle do nothing
+    EXPECT_FALSE(table.invoke(change));
+    EXPECT_FALSE(table.invoke(click, "x"));
+    EXPECT_FALSE(table.invoke(EventHandle()));
+    EXPECT_EQ(table.size(), 2u);
+}
+
+TEST(HandlerTableTest, ReleasedHandlesGoStale) {
+    HandlerTable table;
+    int calls = 0;
+    EventHandle first = table.add([&calls]() { ++calls; });
+    table.release(first);
+    EXPECT_FALSE(table.contains(first));
+    EXPECT_FALSE(table.invoke(first));
+
+    // The slot is recycled under a new generation
+    EventHandle second = table.add([&calls]() { calls += 10; });
+    EXPECT_EQ(second.slot, first.slot);
+    EXPECT_NE(second, first);
+    EXPECT_FALSE(table.invoke(first));
+    EXPECT_TRUE(table.invoke(second));
+    EXPECT_EQ(calls, 10);
+
+    table.release(first);  // Stale: no effect on the new occupant
+    EXPECT_TRUE(table.contains(second));
+}
+
+TEST(HandlerTableTest, ReplaceKeepsHandle) {
+    HandlerTable table;
+    int value = 0;
+    EventHandle handle = table.add([&value]() { value = 1; });
+    EXPECT_TRUE(table.replace(handle, [&value]() { value = 2; }));
+    EXPECT_TRUE(table.invoke(handle));
+    EXPECT_EQ(value, 2);
+}
+
+TEST(HandlerTableTest, HandlerMayReleaseOrReplaceItself) {
+    HandlerTable table;
+    int calls = 0;
+    EventHandle self;
+    self = table.add([&]() {
+        ++calls;
+        table.release(self);
+        table.add([]() {});  // Adding while dispatching is fine too
+    });
+    EXPECT_TRUE(table.invoke(self));
+    EXPECT_FALSE(table.invoke(self));
+    EXPECT_EQ(calls, 1);
+
+    EventHandle swapped;
+    swapped = table.add([&]() {
+        table.replace(swapped, [&calls]() { calls += 100; });
+    });
+    EXPECT_TRUE(table.invoke(swapped));
+    EXPECT_TRUE(table.invoke(swapped));
+    EXPECT_EQ(calls, 101);
+}
+
+TEST(HandlerTableTest, HandlesKeepPropsEqualAcrossRenders) {
+    HandlerTable table;
+    EventHandle handle = table.add([]() {});
+
+    Props first;
+    first.set(keys::width, 100);
+    first.set(keys::onClick, handle);
+    Props second;
+    second.set(keys::width, 100);
+    second.set(keys::onClick, handle);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first.hash(), second.hash());
+
+    // Re-created lambdas are not equal, but they paint the same
+    Props lambdaA;
+    lambdaA.set(keys::width, 100);
+    lambdaA.set(keys::onClick, std::function<void()>([] {}));
+    Props lambdaB;
+    lambdaB.set(keys::width, 100);
+    lambdaB.set(keys::onClick, std::function<void()>([] {}));
+    EXPECT_NE(lambdaA, lambdaB);
+    EXPECT_TRUE(lambdaA.visuallyEquals(lambdaB));
+    EXPECT_EQ(lambdaA.visualHash(), lambdaB.visualHash());
+
+    // Handlers never count, visual props do
+    Props plain;
+    plain.set(keys::width, 100);
+    EXPECT_TRUE(first.visuallyEquals(plain));
+    EXPECT_TRUE(plain.visuallyEquals(lambdaA));
+    EXPECT_EQ(first.visualHash(), plain.visualHash());
+    plain.set(keys::width, 101);
+    EXPECT_FALSE(first.visuallyEquals(plain));
+}
+
+namespace {
+
+class Clicker : public Component {
+public:
+    int clicks = 0;
+    EventHandle onClick;
+
+    Clicker() {
+        onClick = addHandler([this]() { ++clicks; });
+    }
+
+    VNode::Ptr render() override {
+        Props props;
+        props.set(keys::onClick, onClick);
+        return VNode::createElement("Button", props);
+    }
+};
+
+} // namespace
+
+TEST(HandlerTableTest, ComponentOwnsItsHandlers) {
+    auto& table = HandlerTable::global();
+    size_t before = table.size();
+    EventHandle handle;
+    {
+        Clicker clicker;
+        handle = clicker.onClick;
+        EXPECT_EQ(table.size(), before + 1);
+
+        auto first = clicker.render();
+        auto second = clicker.render();
+        EXPECT_EQ(*first, *second);
+
+        EXPECT_TRUE(table.invoke(*first->getProps().getIf<EventHandle>(keys::onClick)));
+        EXPECT_EQ(clicker.clicks, 1);
+    }
+    EXPECT_EQ(table.size(), before);
+    EXPECT_FALSE(table.invoke(handle));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "reactpp/core/ParallelBuilder.hpp"
+#include "reactpp/core/VNode.hpp"
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+using namespace reactpp;
+
+namespace {
+
+VNode::Ptr buildPanel(size_t index) {
+    auto panel = VNode::createElement("View");
+    for (int row = 0; row < 100; ++row) {
+        panel->appendChild(VNode::createText("panel " + std::to_string(index)));
+    }
+    return panel;
+}
+
+} // namespace
+
+TEST(ParallelBuilderTest, BuildsSubtreesInOrder) {
+    ParallelBuilder builder(4);
+    EXPECT_EQ(builder.threadCount(), 4u);
+    
+    auto panels = builder.build(16, buildPanel);
+    ASSERT_EQ(panels.size(), 16u);
+    for (size_t i = 0; i < panels.size(); ++i) {
+        EXPECT_EQ(panels[i]->getChildren().size(), 100u);
+        EXPECT_EQ(panels[i]->getChildren()[0]->getText(), "panel " + std::to_string(i));
+    }
+}
+
+TEST(ParallelBuilderTest, IdsStayUniqueAcrossThreads) {
+    ParallelBuilder builder(4);
+    auto panels = builder.build(32, buildPanel);
+    
+    auto root = VNode::createElement("View");
+    root->appendChildren(std::move(panels));
+    
+    std::unordered_set<uint64_t> ids;
+    size_t count = 0;
+    std::as_const(*root).visitPreOrder([&](const VNode& node) {
+        ids.insert(node.getId());
+        ++count;
+    });
+    EXPECT_EQ(ids.size(), count);
+    EXPECT_EQ(count, 1u + 32u * 101u);
+}
+
+TEST(ParallelBuilderTest, SplicedSubtreesKnowTheirParent) {
+    ParallelBuilder builder(2, false);
+    auto panels = builder.build(3, buildPanel);
+    auto first = panels[0];
+    
+    auto root = VNode::createElement("View");
+    root->appendChild(VNode::createText("header"));
+    root->appendChildren(std::move(panels));
+    
+    EXPECT_EQ(root->getChildren().size(), 4u);
+    EXPECT_EQ(root->getChildren()[1], first);
+    EXPECT_EQ(first->getParent().lock(), root);
+}
+
+TEST(ParallelBuilderTest, WorkersUseTheirOwnArenas) {
+    ParallelBuilder builder(3);
+    std::vector<FrameArena*> arenas(12);
+    
+    builder.beginFrame();
+    auto panels = builder.build(arenas.size(), [&arenas](size_t index) {
+        arenas[index] = FrameArena::current();
+        return buildPanel(index);
+    });
+    
+    for (auto* arena : arenas) {
+        EXPECT_NE(arena, nullptr);
+    }
+    EXPECT_EQ(FrameArena::current(), nullptr);  // Caller's binding is restored
+    
+    // Two more frames recycle the first one once its trees are gone
+    panels.clear();
+    builder.beginFrame();
+    builder.beginFrame();
+}
+
+TEST(ParallelBuilderTest, PropagatesExceptions) {
+    ParallelBuilder builder(2);
+    EXPECT_THROW(builder.build(8, [](size_t index) -> VNode::Ptr {
+        if (index == 5) throw std::runtime_error("panel failed");
+        return buildPanel(index);
+    }), std::runtime_error);
+    
+    // Still usable afterwards
+    EXPECT_EQ(builder.build(2, buildPanel).size(), 2u);
+}
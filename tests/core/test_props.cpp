@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 #include "reactpp/core/Props.hpp"
+#include "reactpp/core/HandlerTable.hpp"
 #include <string>
 #include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
 
 using namespace reactpp;
 
@@ -72,3 +78,317 @@ TEST(PropsTest, Equality) {
     EXPECT_NE(props1, props2);
 }
 
+
+TEST(PropsTest, InternedKeys) {
+    EXPECT_EQ(PropKey::intern("custom-key"), PropKey::intern("custom-key"));
+    EXPECT_NE(PropKey::intern("custom-key"), PropKey::intern("other-key"));
+    EXPECT_EQ(PropKey::intern("custom-key").name(), "custom-key");
+    EXPECT_FALSE(PropKey::find("never-interned-key").valid());
+    
+    // Well-known keys have fixed ids
+    EXPECT_EQ(PropKey::intern("x"), keys::x);
+    EXPECT_EQ(keys::fontSize.name(), "fontSize");
+    EXPECT_EQ(keys::value.name(), "value");
+}
+
+TEST(PropsTest, StringAndAtomKeysAgree) {
+    Props props;
+    props.set(keys::width, 100);
+    props.set("height", 50);
+    
+    EXPECT_EQ(props.get<int>("width"), 100);
+    EXPECT_EQ(props.get<int>(keys::height), 50);
+    EXPECT_TRUE(props.has(keys::width));
+    EXPECT_FALSE(props.has("never-interned-key"));
+}
+
+TEST(PropsTest, OverwriteChangesType) {
+    Props props;
+    props.set("value", 1);
+    props.set("value", std::string("one"));
+    
+    EXPECT_EQ(props.size(), 1);
+    EXPECT_EQ(props.get<std::string>("value"), "one");
+    EXPECT_THROW(props.get<int>("value"), std::runtime_error);
+}
+
+TEST(PropsTest, SpillsBeyondInlineCapacity) {
+    Props props;
+    for (int i = 0; i < 20; ++i) {
+        props.set("key" + std::to_string(i), i);
+    }
+    
+    EXPECT_EQ(props.size(), 20);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(props.get<int>("key" + std::to_string(i)), i);
+    }
+    
+    props.remove("key3");
+    EXPECT_EQ(props.size(), 19);
+    EXPECT_FALSE(props.has("key3"));
+    EXPECT_EQ(props.get<int>("key19"), 19);
+    
+    Props copy = props;
+    EXPECT_EQ(copy, props);
+}
+
+TEST(PropsTest, MergeReplacesType) {
+    Props props1;
+    props1.set("a", 1);
+    
+    Props props2;
+    props2.set("a", std::string("text"));
+    
+    props1.merge(props2);
+    EXPECT_EQ(props1.get<std::string>("a"), "text");
+}
+
+TEST(PropsTest, EqualityComparesValues) {
+    Props props1;
+    props1.set("a", 1);
+    props1.set("b", std::string("test"));
+    
+    Props props2;
+    props2.set("b", std::string("test"));
+    props2.set("a", 2);
+    
+    EXPECT_NE(props1, props2);
+    
+    props2.set("a", 1);
+    EXPECT_EQ(props1, props2);
+    EXPECT_EQ(props1.hash(), props2.hash());
+}
+
+TEST(PropsTest, HandlersCompareByIdentity) {
+    std::function<void()> handler = [] {};
+    
+    Props props1;
+    props1.set("onClick", handler);
+    EXPECT_EQ(props1, props1);
+    
+    // A fresh lambda is a different handler
+    Props props2;
+    props2.set("onClick", std::function<void()>([] {}));
+    EXPECT_NE(props1, props2);
+    
+    // Plain function pointers compare by address
+    static void (*fn)() = [] {};
+    Props props3;
+    props3.set("onClick", std::function<void()>(fn));
+    Props props4;
+    props4.set("onClick", std::function<void()>(fn));
+    EXPECT_EQ(props3, props4);
+}
+
+namespace {
+struct Insets {
+    int top;
+    int left;
+};
+}
+
+TEST(PropsTest, CustomComparator) {
+    Props props1;
+    props1.set("padding", Insets{1, 2});
+    Props props2;
+    props2.set("padding", Insets{1, 2});
+    
+    // Unregistered types are only equal to themselves
+    EXPECT_NE(props1, props2);
+    
+    PropComparators::registerType<Insets>(
+        [](const Insets& a, const Insets& b) { return a.top == b.top && a.left == b.left; },
+        [](const Insets& value) { return static_cast<uint64_t>(value.top * 31 + value.left); });
+    EXPECT_TRUE(PropComparators::isRegistered(typeid(Insets)));
+    EXPECT_EQ(props1, props2);
+    EXPECT_EQ(props1.hash(), props2.hash());
+    
+    props2.set("padding", Insets{3, 4});
+    EXPECT_NE(props1, props2);
+    
+    PropComparators::unregisterType(typeid(Insets));
+}
+
+namespace {
+struct Nested {
+    Props inner;
+};
+}
+
+TEST(PropsTest, ComparatorsMayUseTheRegistry) {
+    // A comparator that compares props, and registers a type while running,
+    // is called without the registry lock held
+    PropComparators::registerType<Nested>([](const Nested& a, const Nested& b) {
+        PropComparators::registerType<Insets>(
+            [](const Insets& x, const Insets& y) { return x.top == y.top && x.left == y.left; });
+        return a.inner == b.inner;
+    });
+    Props inner;
+    inner.set("padding", 4);
+    Props props1;
+    props1.set("nested", Nested{inner});
+    Props props2;
+    props2.set("nested", Nested{inner});
+    EXPECT_EQ(props1, props2);
+    EXPECT_TRUE(PropComparators::isRegistered(typeid(Insets)));
+    
+    PropComparators::unregisterType(typeid(Insets));
+    PropComparators::unregisterType(typeid(Nested));
+    EXPECT_FALSE(PropComparators::isRegistered(typeid(Nested)));
+}
+
+TEST(PropsTest, ReplacingAHandlerComparatorKeepsItAHandler) {
+    PropComparators::registerType<EventHandle>(
+        [](const EventHandle& a, const EventHandle& b) { return a == b; },
+        [](const EventHandle& h) { return (uint64_t{h.slot} << 32) | h.generation; });
+    EXPECT_TRUE(PropComparators::isHandler(typeid(EventHandle)));
+}
+
+TEST(PropsTest, RvalueSetMovesValue) {
+    Props props;
+    std::string text(64, 'x');
+    props.set("text", std::move(text));
+    EXPECT_EQ(props.get<std::string>("text"), std::string(64, 'x'));
+    
+    const std::string copied = "copied";
+    props.set("text", copied);
+    EXPECT_EQ(props.get<std::string>("text"), "copied");
+    
+    Props moved = std::move(props);
+    EXPECT_EQ(moved.get<std::string>("text"), "copied");
+}
+
+TEST(PropsTest, NonThrowingAccessors) {
+    Props props;
+    props.set(keys::width, 120);
+    props.set(keys::color, std::string("#FF0000"));
+    
+    const int* width = props.getIf<int>(keys::width);
+    ASSERT_NE(width, nullptr);
+    EXPECT_EQ(*width, 120);
+    EXPECT_EQ(props.getIf<float>(keys::width), nullptr);   // Wrong type
+    EXPECT_EQ(props.getIf<int>(keys::height), nullptr);    // Missing
+    
+    // Points at the stored value rather than a copy
+    EXPECT_EQ(props.getIf<std::string>(keys::color), props.getIf<std::string>("color"));
+    
+    EXPECT_EQ(props.getOr(keys::width, 0), 120);
+    EXPECT_EQ(props.getOr(keys::height, 40), 40);
+    EXPECT_EQ(props.getOr(keys::color, 7), 7);
+}
+
+TEST(PropsTest, VisitDispatchesOnStoredType) {
+    Props props;
+    props.set(keys::color, std::string("#00FF00"));
+    props.set(keys::backgroundColor, 0x336699FFu);
+    
+    std::string seen;
+    auto visitor = [&seen](const auto& value) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) {
+            seen = "string:" + value;
+        } else {
+            seen = "uint:" + std::to_string(value);
+        }
+    };
+    
+    EXPECT_TRUE((props.visit<uint32_t, std::string>(keys::color, visitor)));
+    EXPECT_EQ(seen, "string:#00FF00");
+    EXPECT_TRUE((props.visit<uint32_t, std::string>(keys::backgroundColor, visitor)));
+    EXPECT_EQ(seen, "uint:" + std::to_string(0x336699FFu));
+    EXPECT_FALSE((props.visit<int>(keys::color, visitor)));
+    EXPECT_FALSE((props.visit<uint32_t>(keys::width, visitor)));
+}
+
+TEST(PropsTest, BuiltinKeysUseTypedFields) {
+    Props props;
+    props.set(keys::width, 120);
+    props.set(keys::color, 0x112233FFu);
+    props.set("custom", 5);
+    
+    const BuiltinProps& fields = props.builtins();
+    EXPECT_TRUE(fields.has(BuiltinProps::Width));
+    EXPECT_EQ(fields.width, 120);
+    EXPECT_EQ(fields.color, 0x112233FFu);
+    EXPECT_EQ(props.size(), 3u);
+    EXPECT_EQ(props.entries().size(), 1u);  // Only "custom"
+    
+    // Iteration visits both stores, builtins first
+    EXPECT_EQ(static_cast<size_t>(std::distance(props.begin(), props.end())), props.size());
+    std::vector<std::string> names;
+    for (const auto& entry : props) {
+        names.push_back(entry.key.name());
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"width", "color", "custom"}));
+    EXPECT_EQ(std::any_cast<uint32_t>(std::next(props.begin())->value), 0x112233FFu);
+    
+    // The keyed API covers both stores
+    EXPECT_EQ(props.get<int>(keys::width), 120);
+    EXPECT_EQ(props.getType(keys::color), std::type_index(typeid(uint32_t)));
+    EXPECT_THROW(props.get<float>(keys::width), std::runtime_error);
+    
+    // Another type moves the key to the generic entries, and back
+    props.set(keys::color, std::string("#FF0000"));
+    EXPECT_FALSE(fields.has(BuiltinProps::Color));
+    EXPECT_EQ(props.get<std::string>(keys::color), "#FF0000");
+    EXPECT_EQ(props.size(), 3u);
+    props.setBuiltin<BuiltinProps::Color>(0x00FF00FF);
+    EXPECT_EQ(props.getIf<std::string>(keys::color), nullptr);
+    EXPECT_EQ(props.get<uint32_t>(keys::color), 0x00FF00FFu);
+    
+    props.remove(keys::width);
+    EXPECT_FALSE(props.has(keys::width));
+    EXPECT_EQ(props.size(), 2u);
+}
+
+TEST(PropsTest, BuiltinFieldsTakePartInEqualityAndMerge) {
+    Props a;
+    a.set(keys::x, 1);
+    Props b;
+    b.setBuiltin<BuiltinProps::X>(1);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.hash(), b.hash());
+    
+    b.set(keys::x, 2);
+    EXPECT_NE(a, b);
+    
+    Props c;
+    c.set(keys::x, std::string("left"));
+    c.set(keys::y, 3);
+    a.merge(c);
+    EXPECT_EQ(a.get<std::string>(keys::x), "left");
+    EXPECT_EQ(a.get<int>(keys::y), 3);
+    EXPECT_FALSE(a.builtins().has(BuiltinProps::X));
+}
+
+TEST(PropsTest, CopiesShareStorageUntilWritten) {
+    Props original;
+    original.set(keys::width, 10);
+    original.set(keys::onClick, std::function<void()>([] {}));
+    
+    Props copy = original;
+    EXPECT_TRUE(copy.sharesStorageWith(original));
+    EXPECT_EQ(copy, original);
+    EXPECT_EQ(copy.getIf<std::function<void()>>(keys::onClick),
+              original.getIf<std::function<void()>>(keys::onClick));  // Same payload
+    
+    // Removing a missing key is not a write
+    copy.remove("missing");
+    EXPECT_TRUE(copy.sharesStorageWith(original));
+    
+    copy.set(keys::width, 20);
+    EXPECT_FALSE(copy.sharesStorageWith(original));
+    EXPECT_EQ(original.get<int>(keys::width), 10);
+    EXPECT_EQ(copy.get<int>(keys::width), 20);
+    EXPECT_TRUE(copy.has(keys::onClick));
+    
+    // Separately built props never share storage
+    Props rebuilt;
+    rebuilt.set(keys::width, 10);
+    rebuilt.set(keys::onClick, original.get<std::function<void()>>(keys::onClick));
+    EXPECT_FALSE(rebuilt.sharesStorageWith(original));
+    
+    Props empty;
+    EXPECT_TRUE(empty.sharesStorageWith(Props()));
+    empty.merge(original);
+    EXPECT_TRUE(empty.sharesStorageWith(original));
+}
@@ -1,11 +1,451 @@
 #include <gtest/gtest.h>
 #include "reactpp/core/Reconciler.hpp"
+#include "reactpp/core/FiberPool.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
+#include "reactpp/elements/Elements.hpp"
+#include "reactpp/hooks/HookManager.hpp"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace reactpp;
 
-TEST(ReconcilerTest, Placeholder) {
+namespace {
+
+VNode::Ptr row(const std::string& key, int width = 100) {
+    Props props;
+    props.set(keys::width, width);
+    auto node = VNode::createElement("View", props, VNode::createText(key));
+    node->setKey(key);
+    return node;
+}
+
+VNode::Ptr list(std::vector<VNode::Ptr> rows) {
+    return VNode::createElement("View", Props(), std::move(rows));
+}
+
+std::vector<VNode::Ptr> rows(size_t count) {
+    std::vector<VNode::Ptr> result;
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(row("row" + std::to_string(i)));
+    }
+    return result;
+}
+
+// Child fibers of a fiber, in sibling order
+std::vector<FiberNode*> childrenOf(const FiberNode& fiber) {
+    std::vector<FiberNode*> result;
+    for (FiberNode* child = fiber.child.get(); child; child = child->sibling.get()) {
+        result.push_back(child);
+    }
+    return result;
+}
+
+const std::string& keyOf(const FiberNode& fiber) {
+    return *fiber.vnode->getKey();
+}
+
+} // namespace
+
+TEST(ReconcilerTest, FirstRenderPlacesTheRoot) {
+    Reconciler reconciler;
+    auto tree = list(rows(3));
+    auto root = reconciler.reconcile(nullptr, tree);
+    ASSERT_NE(root, nullptr);
+    EXPECT_EQ(root->effectTag, EffectTag::Placement);
+    EXPECT_TRUE(root->effectList.empty());
+
+    // The whole tree gets fibers, mounted with the root
+    auto children = childrenOf(*root);
+    ASSERT_EQ(children.size(), 3u);
+    for (FiberNode* child : children) {
+        EXPECT_EQ(child->effectTag, EffectTag::None);
+        EXPECT_EQ(child->return_, root.get());
+        ASSERT_NE(child->child, nullptr);
+        EXPECT_EQ(child->child->vnode->getType(), VNodeType::Text);
+    }
+    EXPECT_EQ(reconciler.stats().fibers, 7u);
+
+    EXPECT_EQ(reconciler.reconcile(nullptr, nullptr), nullptr);
+    auto removed = reconciler.reconcile(tree, nullptr);
+    EXPECT_EQ(removed->effectTag, EffectTag::Deletion);
+}
+
+TEST(ReconcilerTest, UnchangedSubtreesAreSkipped) {
+    Reconciler reconciler;
+    auto current = list(rows(3));
+    auto root = reconciler.reconcile(current, list(rows(3)));
+    EXPECT_EQ(root->effectTag, EffectTag::None);
+    EXPECT_TRUE(root->effectList.empty());
+    EXPECT_EQ(reconciler.stats().skipped, 1u);
+    EXPECT_EQ(reconciler.stats().fibers, 1u);
+    EXPECT_EQ(root->alternate->vnode, current);
+}
+
+TEST(ReconcilerTest, PropsWithoutAHashAreComparedBeforeSkipping) {
+    struct Item {
+        int id;
+    };
+    auto tree = [](int id, std::function<void()> onClick) {
+        Props props;
+        props.set("item", Item{id});
+        props.set(keys::onClick, std::move(onClick));
+        return list({VNode::createElement("View", props, VNode::createText("item"))});
+    };
+    std::function<void()> handler = []() {};
+
+    // Neither the struct nor the handler is hashed, so the hashes match
+    Reconciler reconciler;
+    auto current = tree(1, handler);
+    auto next = tree(2, handler);
+    ASSERT_EQ(current->structuralHash(), next->structuralHash());
+    auto root = reconciler.reconcile(current, next);
+    EXPECT_EQ(reconciler.stats().updates, 1u);
+    ASSERT_EQ(root->effectList.size(), 1u);
+    EXPECT_TRUE(root->effectList[0]->hasEffect(EffectTag::Update));
+
+    current = tree(1, handler);
+    next = tree(1, []() {});
+    ASSERT_EQ(current->structuralHash(), next->structuralHash());
+    root = reconciler.reconcile(current, next);
+    EXPECT_EQ(reconciler.stats().updates, 1u);
+    EXPECT_EQ(root->effectList.size(), 1u);
+}
+
+TEST(ReconcilerTest, SharedChildrenFollowTheCommittedParent) {
+    Reconciler reconciler;
+    auto tree = list(rows(3));
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, tree);
+    FiberNode* child = current->child.get();
+    EXPECT_EQ(child->return_, current.get());
+
+    // Every later render skips the root and shares its children, which
+    // move to the new root when it commits
+    for (int render = 0; render < 4; ++render) {
+        current = reconciler.reconcile(current, tree);
+        ASSERT_EQ(reconciler.stats().skipped, 1u);
+        ASSERT_EQ(current->child.get(), child);
+        EXPECT_EQ(child->return_, current.get());
+        EXPECT_EQ(child->return_->vnode, tree);
+    }
+    
+    // A render that is not committed leaves them with the committed root
+    FiberNode::Ptr dropped = reconciler.begin(current, tree);
+    while (reconciler.performUnitOfWork()) {
+    }
+    ASSERT_EQ(dropped->child.get(), child);
+    EXPECT_EQ(child->return_, current.get());
+}
+
+TEST(ReconcilerTest, InsertsUpdatesAndDeletesByKey) {
+    Reconciler reconciler;
+    auto current = list({row("a"), row("b"), row("c")});
+    auto next = list({row("a"), row("c", 200), row("d")});
+    auto root = reconciler.reconcile(current, next);
+
+    auto children = childrenOf(*root);
+    ASSERT_EQ(children.size(), 3u);
+    EXPECT_EQ(children[0]->effectTag, EffectTag::None);
+    EXPECT_EQ(children[1]->effectTag, EffectTag::Update);
+    EXPECT_EQ(children[2]->effectTag, EffectTag::Placement);
+    EXPECT_EQ(children[1]->alternate->vnode, std::as_const(*current).getChildren()[2]);
+    EXPECT_EQ(children[2]->alternate, nullptr);
+
+    // Deletions come first; unchanged rows are not descended into
+    ASSERT_EQ(root->effectList.size(), 3u);
+    EXPECT_EQ(root->effectList[0]->effectTag, EffectTag::Deletion);
+    EXPECT_EQ(keyOf(*root->effectList[0]), "b");
+    EXPECT_EQ(root->effectList[0]->return_, root.get());
+    EXPECT_EQ(root->effectList[1].get(), children[1]);
+    EXPECT_EQ(root->effectList[2].get(), children[2]);
+    EXPECT_EQ(reconciler.stats().skipped, 2u);  // Row a and c's label
+    EXPECT_EQ(reconciler.stats().deletions, 1u);
+    EXPECT_EQ(reconciler.stats().updates, 1u);
+}
+
+TEST(ReconcilerTest, ReorderMovesOnlyDisplacedRows) {
+    Reconciler reconciler;
+    auto before = rows(1000);
+    auto current = list(before);
+
+    // Last row to the front: one move, every other row stays put
+    auto moved = rows(1000);
+    std::rotate(moved.begin(), moved.end() - 1, moved.end());
+    auto root = reconciler.reconcile(current, list(moved));
+    ASSERT_EQ(root->effectList.size(), 1u);
+    EXPECT_EQ(root->effectList[0]->effectTag, EffectTag::Placement);
+    EXPECT_EQ(keyOf(*root->effectList[0]), "row999");
+    EXPECT_EQ(reconciler.stats().moves, 1u);
+    EXPECT_EQ(reconciler.stats().skipped, 1000u);
+    EXPECT_EQ(reconciler.stats().fibers, 1001u);
+
+    // Swapping two distant rows moves both
+    auto swapped = rows(1000);
+    std::swap(swapped[10], swapped[500]);
+    root = reconciler.reconcile(current, list(swapped));
+    EXPECT_EQ(reconciler.stats().moves, 2u);
+    EXPECT_EQ(root->effectList.size(), 2u);
+
+    // Reversal keeps one row in place
+    auto reversed = rows(1000);
+    std::reverse(reversed.begin(), reversed.end());
+    root = reconciler.reconcile(current, list(reversed));
+    EXPECT_EQ(reconciler.stats().moves, 999u);
+    EXPECT_EQ(reconciler.stats().deletions, 0u);
+}
+
+TEST(ReconcilerTest, MovedRowCanAlsoUpdate) {
+    Reconciler reconciler;
+    auto current = list({row("a"), row("b"), row("c")});
+    auto root = reconciler.reconcile(current, list({row("c", 300), row("a"), row("b")}));
+    auto children = childrenOf(*root);
+    ASSERT_EQ(children.size(), 3u);
+    EXPECT_EQ(children[0]->effectTag, EffectTag::Placement | EffectTag::Update);
+    EXPECT_TRUE(children[0]->hasEffect(EffectTag::Update));
+    EXPECT_EQ(children[1]->effectTag, EffectTag::None);
+    EXPECT_EQ(children[2]->effectTag, EffectTag::None);
+}
+
+TEST(ReconcilerTest, UnkeyedChildrenMatchByTypeAndPosition) {
     Reconciler reconciler;
-    // Tests to be implemented
-    EXPECT_TRUE(true);
+    auto current = VNode::createElement("View", Props(),
+        VNode::createElement("View"), VNode::createText("label"));
+    auto next = VNode::createElement("View", Props(),
+        VNode::createElement("Button"), VNode::createText("label 2"));
+    auto root = reconciler.reconcile(current, next);
+
+    auto children = childrenOf(*root);
+    ASSERT_EQ(children.size(), 2u);
+    EXPECT_EQ(children[0]->effectTag, EffectTag::Placement);
+    EXPECT_EQ(children[1]->effectTag, EffectTag::Update);
+    EXPECT_EQ(reconciler.stats().deletions, 1u);
+    EXPECT_EQ(reconciler.stats().moves, 0u);
+
+    // A different root type replaces the whole tree
+    root = reconciler.reconcile(current, VNode::createElement("Button"));
+    EXPECT_EQ(root->effectTag, EffectTag::Placement);
+    ASSERT_EQ(root->effectList.size(), 1u);
+    EXPECT_EQ(root->effectList[0]->vnode, current);
+}
+
+TEST(ReconcilerTest, ImplicitKeysMatchAcrossConditionalSiblings) {
+    ImplicitKeys::Scope implicitKeys;
+    auto render = [](bool showBanner) {
+        std::vector<VNode::Ptr> children;
+        if (showBanner) {
+            children.push_back(elements::Text("Banner"));
+        }
+        children.push_back(elements::Text("Body"));
+        children.push_back(elements::Button(elements::props().width(80)));
+        return elements::View({}, std::move(children));
+    };
+
+    Reconciler reconciler;
+    auto root = reconciler.reconcile(render(false), render(true));
+    ASSERT_EQ(root->effectList.size(), 1u);
+    EXPECT_EQ(root->effectList[0]->effectTag, EffectTag::Placement);
+    EXPECT_EQ(root->effectList[0]->vnode->getText(), "Banner");
+    EXPECT_EQ(reconciler.stats().deletions, 0u);
+}
+
+TEST(ReconcilerTest, RecyclesAlternatesAcrossRenders) {
+    auto render = [](int width) {
+        std::vector<VNode::Ptr> children;
+        for (int i = 0; i < 100; ++i) {
+            children.push_back(row("row" + std::to_string(i), width));
+        }
+        return list(std::move(children));
+    };
+
+    Reconciler reconciler;
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, render(0));
+    FiberNode::Ptr previous;
+    for (int width = 1; width <= 3; ++width) {
+        previous = std::exchange(current, reconciler.reconcile(current, render(width)));
+        EXPECT_EQ(current->alternate, previous);
+        EXPECT_EQ(previous->alternate, nullptr);  // Only the newer fiber points at the older
+        EXPECT_EQ(current->effectList.size(), 100u);
+    }
+
+    // Both buffers exist: every fiber is the one from two renders ago
+    size_t allocated = FiberPool::global().allocated();
+    FiberNode* twoAgo = previous.get();
+    auto next = reconciler.reconcile(current, render(4));
+    EXPECT_EQ(next.get(), twoAgo);
+    EXPECT_EQ(reconciler.stats().fibers, 201u);  // Root, rows and their labels
+    EXPECT_EQ(reconciler.stats().reused, reconciler.stats().fibers);
+    EXPECT_EQ(reconciler.stats().updates, 100u);
+    EXPECT_EQ(FiberPool::global().allocated(), allocated);
+
+    auto children = childrenOf(*next);
+    ASSERT_EQ(children.size(), 100u);
+    EXPECT_EQ(children[0]->return_, next.get());
+    EXPECT_EQ(children[0]->alternate->vnode->getKey(), children[0]->vnode->getKey());
+    EXPECT_EQ(children[0]->memoizedProps.get<int>(keys::width), 4);
+}
+
+namespace {
+
+// Renders its "text" prop and counts the renders
+class Label : public Component {
+public:
+    int renders = 0;
+
+    VNode::Ptr render() override {
+        ++renders;
+        return VNode::createText(getProps().get<std::string>("text"));
+    }
+};
+
+VNode::Ptr label(const std::shared_ptr<Label>& component, const std::string& text, int width = 100) {
+    Props props;
+    props.set("text", text);
+    props.set(keys::width, width);
+    return VNode::createComponent(component, props);
 }
 
+} // namespace
+
+TEST(ReconcilerTest, CleanComponentsWithEqualPropsAreNotRendered) {
+    auto first = std::make_shared<Label>();
+    auto second = std::make_shared<Label>();
+    Reconciler reconciler;
+    auto render = [&](const std::string& text) {
+        return list({label(first, "first"), label(second, text)});
+    };
+
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, render("a"));
+    EXPECT_EQ(reconciler.stats().renders, 2u);
+    auto next = reconciler.reconcile(current, render("b"));
+    EXPECT_EQ(reconciler.stats().renders, 1u);
+    EXPECT_EQ(reconciler.stats().bailouts, 1u);
+    EXPECT_EQ(first->renders, 1);
+    EXPECT_EQ(second->renders, 2);
+
+    // The clean component keeps its output; the other's text is updated
+    auto before = childrenOf(*current);
+    auto after = childrenOf(*next);
+    ASSERT_EQ(after.size(), 2u);
+    EXPECT_EQ(after[0]->child, before[0]->child);
+    ASSERT_NE(after[1]->child, nullptr);
+    EXPECT_EQ(after[1]->child->vnode->getText(), "b");
+    // Updates for the changed component node and its text
+    ASSERT_EQ(next->effectList.size(), 2u);
+    EXPECT_EQ(next->effectList[0].get(), after[1]);
+    EXPECT_EQ(next->effectList[1], after[1]->child);
+    EXPECT_TRUE(next->effectList[1]->hasEffect(EffectTag::Update));
+}
+
+TEST(ReconcilerTest, DirtyHooksRenderThroughUnchangedAncestors) {
+    auto component = std::make_shared<Label>();
+    auto hooks = std::make_shared<HookManager>();
+    component->setHookManager(hooks);
+    auto tree = list({row("header"), list({label(component, "text")})});
+
+    Reconciler reconciler;
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, tree);
+    current = reconciler.reconcile(current, tree);
+    EXPECT_EQ(reconciler.stats().renders, 0u);
+    EXPECT_EQ(reconciler.stats().skipped, 1u);  // The header row; the lists hold a component
+    EXPECT_EQ(reconciler.stats().bailouts, 1u);
+
+    // The same tree again, but the component has pending state
+    hooks->markDirty();
+    current = reconciler.reconcile(current, tree);
+    EXPECT_EQ(reconciler.stats().renders, 1u);
+    EXPECT_EQ(component->renders, 2);
+    EXPECT_FALSE(hooks->isDirty());
+    EXPECT_EQ(reconciler.stats().skipped, 2u);  // The header row and the rendered text
+}
+
+TEST(ReconcilerTest, MemoComparesPropsWithTheGivenFunction) {
+    auto component = memo<Label>([](const Props& a, const Props& b) {
+        return a.get<std::string>("text") == b.get<std::string>("text");
+    });
+    Reconciler reconciler;
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, label(component, "text", 100));
+    current = reconciler.reconcile(current, label(component, "text", 200));
+    EXPECT_EQ(reconciler.stats().bailouts, 1u);
+    EXPECT_EQ(component->renders, 1);
+
+    current = reconciler.reconcile(current, label(component, "other", 200));
+    EXPECT_EQ(reconciler.stats().renders, 1u);
+    EXPECT_EQ(component->renders, 2);
+}
+
+TEST(ReconcilerTest, MemoComparatorDecidesUnderUnchangedAncestors) {
+    struct Item {
+        int id;
+    };
+    auto component = memo<Label>([](const Props& a, const Props& b) {
+        return a.get<Item>("item").id == b.get<Item>("item").id;
+    });
+    auto tree = [&](int id) {
+        Props props;
+        props.set("text", std::to_string(id));
+        props.set("item", Item{id});
+        return list({row("header"), list({VNode::createComponent(component, props)})});
+    };
+
+    Reconciler reconciler;
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, tree(1));
+    current = reconciler.reconcile(current, tree(1));
+    EXPECT_EQ(reconciler.stats().bailouts, 1u);
+    current = reconciler.reconcile(current, tree(2));
+    EXPECT_EQ(reconciler.stats().renders, 1u);
+    EXPECT_EQ(component->renders, 2);
+    auto text = childrenOf(*childrenOf(*current)[1])[0]->child;
+    ASSERT_NE(text, nullptr);
+    EXPECT_EQ(text->vnode->getText(), "2");
+
+    // The very same tree is still offered to a comparator that says no
+    auto always = memo<Label>([](const Props&, const Props&) { return false; });
+    Props props;
+    props.set("text", std::string("text"));
+    auto same = list({list({VNode::createComponent(always, props)})});
+    current = reconciler.reconcile(nullptr, same);
+    current = reconciler.reconcile(current, same);
+    EXPECT_EQ(reconciler.stats().renders, 1u);
+    EXPECT_EQ(always->renders, 2);
+}
+
+TEST(ReconcilerTest, ComponentsChangeOnlyWhenTheRenderCommits) {
+    auto component = std::make_shared<Label>();
+    auto hooks = std::make_shared<HookManager>();
+    component->setHookManager(hooks);
+    auto tree = [&](const std::string& text) {
+        return list({row("a"), row("b"), list({label(component, text)})});
+    };
+
+    Reconciler reconciler;
+    FiberNode::Ptr current = reconciler.reconcile(nullptr, tree("first"));
+    EXPECT_EQ(component->getProps().get<std::string>("text"), "first");
+
+    // Render the update, then drop it before it commits
+    hooks->markDirty();
+    reconciler.begin(current, tree("second"));
+    while (reconciler.performUnitOfWork()) {
+    }
+    EXPECT_EQ(component->renders, 2);
+    EXPECT_EQ(component->getProps().get<std::string>("text"), "first");
+    EXPECT_TRUE(hooks->isDirty());
+    reconciler.begin(nullptr, nullptr);
+    reconciler.commit();
+    EXPECT_EQ(component->getProps().get<std::string>("text"), "first");
+    EXPECT_TRUE(hooks->isDirty());
+
+    // A mark that arrives mid-render survives the commit
+    FiberNode::Ptr next = reconciler.begin(current, tree("second"));
+    while (reconciler.performUnitOfWork()) {
+        hooks->markDirty();
+    }
+    reconciler.commit();
+    EXPECT_EQ(component->getProps().get<std::string>("text"), "second");
+    EXPECT_TRUE(hooks->isDirty());
+
+    next = reconciler.reconcile(next, tree("second"));
+    EXPECT_EQ(reconciler.stats().renders, 1u);
+    EXPECT_FALSE(hooks->isDirty());
+}
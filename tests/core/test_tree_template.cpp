@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "reactpp/core/HandlerTable.hpp"
+#include "reactpp/core/NodeBlock.hpp"
+#include "reactpp/elements/Elements.hpp"
+#include "reactpp/elements/Template.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+using namespace reactpp;
+using namespace reactpp::elements;
+
+namespace {
+
+constexpr auto Card = tmpl::View(tmpl::props().width(300).height(80).backgroundColor(0x223344FF),
+    tmpl::Text(tmpl::slot<0>, tmpl::props().fontSize(18)),
+    tmpl::slot<2>,
+    tmpl::Button(tmpl::props().width(120).bind<1>(keys::onClick),
+        tmpl::Text("Open")));
+
+// The description is flattened at compile time
+constexpr auto CardRows = tmpl::flatten(Card);
+static_assert(decltype(Card)::nodeCount == 5);
+static_assert(decltype(Card)::slotCount == 3);
+static_assert(CardRows.nodes[0].childCount == 3);
+static_assert(CardRows.nodes[0].builtins.getOr<BuiltinProps::Width>(0) == 300);
+static_assert(CardRows.nodes[1].kind == tmpl::NodeKind::TextSlot);
+static_assert(CardRows.nodes[2].kind == tmpl::NodeKind::ChildSlot && CardRows.nodes[2].slot == 2);
+static_assert(CardRows.nodes[3].bindingCount == 1 && CardRows.bindings[0].key == keys::onClick);
+static_assert(CardRows.nodes[4].text == "Open");
+
+} // namespace
+
+TEST(TreeTemplateTest, MatchesTheRuntimeBuild) {
+    static const TreeTemplate card(Card);
+    EventHandle open = HandlerTable::global().add([] {});
+    
+    auto fromTemplate = card(std::string("Title"), open, Text("extra"));
+    auto byHand = View(props().width(300).height(80).backgroundColor(0x223344FF),
+        Text("Title", props().fontSize(18)),
+        Text("extra"),
+        Button(props().width(120).onClick(open), Text("Open")));
+    EXPECT_EQ(*fromTemplate, *byHand);
+    
+    // Slots take new values each call; static props are shared
+    auto again = card(std::string("Other"), open, Text("extra"));
+    EXPECT_EQ(std::as_const(*again).getChildren()[0]->getText(), "Other");
+    EXPECT_TRUE(again->getProps().sharesStorageWith(fromTemplate->getProps()));
+    EXPECT_NE(*again, *fromTemplate);
+    
+    HandlerTable::global().release(open);
+}
+
+TEST(TreeTemplateTest, NodesOutliveTheTemplateCall) {
+    constexpr auto List = tmpl::View(tmpl::props(), tmpl::Text("a"), tmpl::Text("b"), tmpl::Text("c"));
+    TreeTemplate list(List);
+    
+    VNode::Ptr child;
+    {
+        auto tree = list();
+        child = std::as_const(*tree).getChildren()[2];
+    }
+    // The block stays alive while any of its nodes does
+    EXPECT_EQ(child->getText(), "c");
+    EXPECT_EQ(child->getParent().lock(), nullptr);
+    
+    // Trees stay editable
+    auto tree = list();
+    tree->appendChild(Text("d"));
+    EXPECT_EQ(tree->getChildren().size(), 4u);
+}
+
+TEST(TreeTemplateTest, RejectsWrongSlotTypes) {
+    constexpr auto Label = tmpl::View(tmpl::props(), tmpl::Text(tmpl::slot<0>));
+    TreeTemplate label(Label);
+    EXPECT_THROW(label(42), std::runtime_error);
+    EXPECT_EQ(std::as_const(*label("ok")).getChildren()[0]->getText(), "ok");
+}
+
+TEST(NodeBlockTest, OverflowFallsBackToTheHeap) {
+    NodeBlock* block = NodeBlock::create(64);
+    VNode::Ptr root;
+    {
+        NodeBlock::Scope scope(*block);
+        root = VNode::createElement("View", Props(), VNode::createText("a"), VNode::createText("b"));
+    }
+    EXPECT_GT(block->bytesRequested(), block->capacity());
+    block->release();
+    EXPECT_EQ(std::as_const(*root).getChildren().size(), 2u);
+}
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
+#include "reactpp/core/Component.hpp"
+#include "reactpp/core/ImplicitKeys.hpp"
 #include "reactpp/core/VNode.hpp"
 #include "reactpp/core/Props.hpp"
+#include "reactpp/elements/Elements.hpp"
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 using namespace reactpp;
 
@@ -72,3 +80,531 @@ TEST(VNodeTest, FindByKey) {
     EXPECT_EQ(found->getKey().value(), "key2");
 }
 
+TEST(VNodeTest, FindChildByKeyOnlyLooksAtChildren) {
+    auto root = VNode::createElement("root");
+    auto child = VNode::createElement("child");
+    auto grandchild = VNode::createElement("grandchild");
+    grandchild->setKey("deep");
+    child->appendChild(grandchild);
+    root->appendChild(child);
+    
+    EXPECT_EQ(root->findChildByKey("deep"), nullptr);
+    EXPECT_EQ(root->findDescendantByKey("deep"), grandchild);
+    EXPECT_EQ(child->findChildByKey("deep"), grandchild);
+}
+
+TEST(VNodeTest, IndexTracksTreeOperations) {
+    auto root = VNode::createElement("root");
+    root->enableIndex();
+    
+    auto a = VNode::createElement("a");
+    a->setKey("a");
+    auto b = VNode::createElement("b");
+    b->setKey("b");
+    auto nested = VNode::createText("nested");
+    b->appendChild(nested);
+    
+    root->appendChild(a);
+    root->insertBefore(b, a);
+    EXPECT_TRUE(nested->isIndexed());
+    EXPECT_EQ(root->findById(nested->getId()), nested);
+    EXPECT_EQ(root->findChildByKey("b"), b);
+    EXPECT_EQ(a->findById(nested->getId()), nullptr);  // Not below a
+    
+    b->setKey("renamed");
+    EXPECT_EQ(root->findChildByKey("b"), nullptr);
+    EXPECT_EQ(root->findChildByKey("renamed"), b);
+    
+    auto c = VNode::createElement("c");
+    c->setKey("c");
+    root->replaceChild(a, c);
+    EXPECT_FALSE(a->isIndexed());
+    EXPECT_EQ(root->findChildByKey("a"), nullptr);
+    EXPECT_EQ(root->findChildByKey("c"), c);
+    EXPECT_EQ(root->findById(a->getId()), nullptr);
+    
+    root->removeChild(b);
+    EXPECT_FALSE(nested->isIndexed());
+    EXPECT_EQ(root->findById(nested->getId()), nullptr);
+    EXPECT_EQ(b->findById(nested->getId()), nested);  // Unindexed lookup still works
+    
+    root->disableIndex();
+    EXPECT_FALSE(c->isIndexed());
+    EXPECT_EQ(root->findChildByKey("c"), c);
+}
+
+TEST(VNodeTest, IndexKeepsDuplicateSiblingKeysResolvable) {
+    auto root = VNode::createElement("root");
+    auto first = VNode::createElement("first");
+    first->setKey("dup");
+    auto second = VNode::createElement("second");
+    second->setKey("dup");
+    root->appendChild(first);
+    root->appendChild(second);
+    root->enableIndex();
+    
+    EXPECT_EQ(root->findChildByKey("dup"), first);
+    root->removeChild(first);
+    EXPECT_EQ(root->findChildByKey("dup"), second);
+}
+
+
+TEST(VNodeTest, StructuralHashMatchesEqualTrees) {
+    Props props;
+    props.set("width", 100);
+    auto a = VNode::createElement("div", props, {VNode::createText("Hello")});
+    auto b = VNode::createElement("div", props, {VNode::createText("Hello")});
+    
+    EXPECT_EQ(a->structuralHash(), b->structuralHash());
+    EXPECT_TRUE(a->isSameSubtree(*b));
+    EXPECT_EQ(*a, *b);
+    
+    auto c = VNode::createElement("div", props, {VNode::createText("World")});
+    EXPECT_NE(a->structuralHash(), c->structuralHash());
+    EXPECT_NE(*a, *c);
+}
+
+TEST(VNodeTest, StructuralHashCoversPropValues) {
+    Props props1;
+    props1.set("width", 100);
+    Props props2;
+    props2.set("width", 200);
+    
+    auto a = VNode::createElement("div", props1);
+    auto b = VNode::createElement("div", props2);
+    EXPECT_FALSE(a->isSameSubtree(*b));
+}
+
+TEST(VNodeTest, SameSubtreeComparesPropsTheHashIgnores) {
+    struct Item {
+        int id;
+    };
+    auto tree = [](int id, std::function<void()> onClick) {
+        Props props;
+        props.set("item", Item{id});
+        Props buttonProps;
+        buttonProps.set(keys::onClick, std::move(onClick));
+        return VNode::createElement("View", props, VNode::createElement("Button", buttonProps));
+    };
+    std::function<void()> handler = []() {};
+    auto a = tree(1, handler);
+    auto b = tree(2, handler);
+    
+    // Neither value is hashed: equal hashes, but not the same subtree
+    EXPECT_EQ(a->structuralHash(), b->structuralHash());
+    EXPECT_FALSE(a->isSameSubtree(*b));
+    EXPECT_TRUE(a->isSameSubtree(*a));
+    
+    // Only the handler differs
+    auto c = VNode::createElement("View", Props(), VNode::createElement("Button", a->getChildren()[0]->getProps()));
+    auto d = VNode::createElement("View", Props(), VNode::createElement("Button", b->getChildren()[0]->getProps()));
+    EXPECT_FALSE(c->isSameSubtree(*d));  // Different stored handler objects
+    auto e = VNode::createElement("View", Props(), VNode::createElement("Button", std::as_const(*c->getChildren()[0]).getProps()));
+    EXPECT_TRUE(c->isSameSubtree(*e));   // Shared props storage: the same handler
+}
+
+TEST(VNodeTest, StructuralHashInvalidatedByMutation) {
+    auto root = VNode::createElement("root");
+    auto child = VNode::createElement("child");
+    root->appendChild(child);
+    
+    uint64_t before = root->structuralHash();
+    
+    child->getProps().set("color", uint32_t{0xFF0000FF});
+    uint64_t afterProps = root->structuralHash();
+    EXPECT_NE(before, afterProps);
+    
+    child->setKey("k");
+    EXPECT_NE(afterProps, root->structuralHash());
+    
+    uint64_t beforeAppend = root->structuralHash();
+    root->appendChild(VNode::createText("more"));
+    EXPECT_NE(beforeAppend, root->structuralHash());
+}
+
+TEST(VNodeTest, VisitorControlsTraversal) {
+    auto root = VNode::createElement("root");
+    auto skipped = VNode::createElement("skipped");
+    skipped->appendChild(VNode::createText("hidden"));
+    auto last = VNode::createElement("last");
+    root->appendChild(skipped);
+    root->appendChild(last);
+    root->appendChild(VNode::createElement("after"));
+    
+    std::vector<std::string> tags;
+    bool completed = root->visitPreOrder([&tags](const VNode& node) {
+        tags.push_back(node.getTag());
+        if (node.getTag() == "skipped") return VisitResult::SkipChildren;
+        if (node.getTag() == "last") return VisitResult::Stop;
+        return VisitResult::Continue;
+    });
+    
+    EXPECT_FALSE(completed);
+    EXPECT_EQ(tags, (std::vector<std::string>{"root", "skipped", "last"}));
+    
+    std::vector<std::string> postOrder;
+    EXPECT_TRUE(root->visitPostOrder([&postOrder](VNode& node) {
+        postOrder.push_back(node.getType() == VNodeType::Text ? node.getText() : node.getTag());
+    }));
+    EXPECT_EQ(postOrder, (std::vector<std::string>{"hidden", "skipped", "last", "after", "root"}));
+}
+
+TEST(VNodeTest, DeepTreeTraversalIsIterative) {
+    auto root = VNode::createElement("root");
+    auto current = root;
+    for (int i = 0; i < 100000; ++i) {
+        auto child = VNode::createElement("level");
+        current->appendChild(child);
+        current = child;
+    }
+    
+    size_t count = 0;
+    root->visitPreOrder([&count](const VNode&) { ++count; });
+    EXPECT_EQ(count, 100001u);
+    EXPECT_EQ(root->findById(current->getId()), current);
+    EXPECT_NE(root->structuralHash(), 0u);
+    
+    // An equal copy with its own nodes is compared without recursing
+    auto copy = VNode::createElement("root");
+    auto last = copy;
+    for (int i = 0; i < 100000; ++i) {
+        auto child = VNode::createElement("level");
+        last->appendChild(child);
+        last = child;
+    }
+    EXPECT_EQ(*root, *copy);
+    EXPECT_TRUE(root->isSameSubtree(*copy));
+    
+    // Unlink iteratively so destruction doesn't recurse either
+    for (auto tree : {root, copy}) {
+        while (!tree->getChildren().empty()) {
+            auto child = tree->getChildren()[0];
+            tree->removeChild(child);
+            tree = child;
+        }
+    }
+}
+
+TEST(VNodeTest, VariadicChildrenFactories) {
+    auto a = VNode::createText("a");
+    auto b = VNode::createText("b");
+    Props props;
+    props.set(keys::width, 10);
+    
+    auto element = VNode::createElement("div", std::move(props), a, b, VNode::createText("c"));
+    ASSERT_EQ(element->getChildren().size(), 3u);
+    EXPECT_EQ(element->getChildren()[0], a);
+    EXPECT_EQ(element->getChildren()[2]->getText(), "c");
+    EXPECT_EQ(b->getParent().lock(), element);
+    EXPECT_EQ(element->getProps().get<int>(keys::width), 10);
+    
+    auto fragment = VNode::createFragment(VNode::createText("x"), VNode::createText("y"));
+    ASSERT_EQ(fragment->getChildren().size(), 2u);
+    EXPECT_EQ(fragment->getChildren()[1]->getParent().lock(), fragment);
+    
+    // Vector overload still takes braced lists
+    auto listed = VNode::createElement("div", Props(), {VNode::createText("z")});
+    EXPECT_EQ(listed->getChildren().size(), 1u);
+}
+
+TEST(VNodeTest, TagsAreInterned) {
+    auto view = VNode::createElement("View");
+    EXPECT_EQ(view->getTagId(), tags::View);
+    EXPECT_EQ(view->getTag(), "View");
+    
+    auto custom = VNode::createElement("CustomWidget");
+    auto again = VNode::createElement(std::string("CustomWidget"));
+    EXPECT_TRUE(custom->getTagId().valid());
+    EXPECT_EQ(custom->getTagId(), again->getTagId());
+    EXPECT_EQ(TagId::find("CustomWidget"), custom->getTagId());
+    EXPECT_FALSE(TagId::find("NeverUsedTag").valid());
+    
+    auto text = VNode::createText("hi");
+    EXPECT_FALSE(text->getTagId().valid());
+    EXPECT_EQ(text->getTag(), "");
+    
+    switch (view->getTagId().id()) {
+        case tags::ViewId:
+            break;
+        default:
+            FAIL() << "built-in tag did not dispatch";
+    }
+}
+
+TEST(VNodeTest, FrozenNodesRejectMutation) {
+    auto root = VNode::createElement("root", Props(), {VNode::createText("child")});
+    root->freeze();
+    EXPECT_TRUE(root->isFrozen());
+    EXPECT_FALSE(std::as_const(*root).getChildren().empty());  // Const reads are fine
+    
+    auto child = std::as_const(*root).getChildren()[0];
+    EXPECT_TRUE(child->isFrozen());
+    EXPECT_THROW(root->appendChild(VNode::createText("more")), std::runtime_error);
+    EXPECT_THROW(root->removeChild(child), std::runtime_error);
+    EXPECT_THROW(child->setKey("k"), std::runtime_error);
+    EXPECT_THROW(root->getProps(), std::runtime_error);
+    EXPECT_THROW(root->enableIndex(), std::runtime_error);
+    
+    // Clones of frozen trees are the tree itself
+    EXPECT_EQ(root->cloneDeep(), root);
+}
+
+TEST(VNodeTest, PathCopyingSharesUntouchedSubtrees) {
+    auto left = VNode::createElement("left", Props(), {VNode::createText("a")});
+    auto target = VNode::createElement("target");
+    auto right = VNode::createElement("right", Props(), {target});
+    auto root = VNode::createElement("root", Props(), {left, right});
+    root->freeze();
+    uint64_t oldHash = root->structuralHash();
+    
+    auto updated = VNode::updateIn(root, *target, [](VNode& node) {
+        node.getProps().set(keys::width, 42);
+    });
+    
+    ASSERT_NE(updated, root);
+    EXPECT_TRUE(updated->isFrozen());
+    const auto& children = std::as_const(*updated).getChildren();
+    EXPECT_EQ(children[0], left);    // Shared
+    EXPECT_NE(children[1], right);   // On the path: copied
+    auto newTarget = std::as_const(*children[1]).getChildren()[0];
+    EXPECT_EQ(std::as_const(*newTarget).getProps().get<int>(keys::width), 42);
+    
+    // The old tree is untouched
+    EXPECT_FALSE(std::as_const(*target).getProps().has(keys::width));
+    EXPECT_EQ(root->structuralHash(), oldHash);
+    EXPECT_NE(updated->structuralHash(), oldHash);
+    
+    // Old trees can still be updated even though parent links now follow the new one
+    auto fromOld = VNode::updateIn(root, *left, [](VNode& node) { node.setKey("l"); });
+    EXPECT_EQ(std::as_const(*fromOld).getChildren()[1], right);
+    EXPECT_EQ(std::as_const(*fromOld).getChildren()[0]->getKey().value(), "l");
+    
+    auto detached = VNode::createElement("elsewhere");
+    detached->freeze();
+    EXPECT_THROW(VNode::updateIn(root, *detached, [](VNode&) {}), std::runtime_error);
+}
+
+TEST(VNodeTest, PersistentChildUpdates) {
+    auto a = VNode::createText("a");
+    auto b = VNode::createText("b");
+    auto root = VNode::createElement("list", Props(), {a, b});
+    root->freeze();
+    
+    auto appended = root->withChildAppended(VNode::createText("c"));
+    auto removed = appended->withChildRemoved(a);
+    auto replaced = removed->withChildReplaced(b, VNode::createText("B"));
+    
+    EXPECT_EQ(std::as_const(*root).getChildren().size(), 2u);
+    EXPECT_EQ(std::as_const(*appended).getChildren().size(), 3u);
+    ASSERT_EQ(std::as_const(*replaced).getChildren().size(), 2u);
+    EXPECT_EQ(std::as_const(*replaced).getChildren()[0]->getText(), "B");
+    EXPECT_TRUE(replaced->isFrozen());
+    EXPECT_TRUE(std::as_const(*appended).getChildren()[2]->isFrozen());
+}
+
+TEST(VNodeTest, CloneDeepSharesFrozenSubtrees) {
+    auto shared = VNode::createElement("static", Props(), {VNode::createText("x")});
+    shared->freeze();
+    auto root = VNode::createElement("root", Props(), {shared, VNode::createText("dynamic")});
+    
+    auto cloned = root->cloneDeep();
+    EXPECT_EQ(cloned->getChildren()[0], shared);
+    EXPECT_NE(cloned->getChildren()[1], root->getChildren()[1]);
+    EXPECT_EQ(*cloned, *root);
+}
+
+TEST(VNodeTest, StableIdsSurviveRerender) {
+    auto render = [](bool swapped) {
+        auto first = VNode::createElement("Button");
+        first->setKey("a");
+        auto second = VNode::createElement("Button");
+        second->setKey("b");
+        auto root = swapped ? VNode::createElement("View", Props(), second, first, VNode::createText("x"))
+                            : VNode::createElement("View", Props(), first, second, VNode::createText("x"));
+        root->assignStableIds();
+        return root;
+    };
+    
+    auto before = render(false);
+    auto after = render(true);
+    EXPECT_NE(before->getId(), after->getId());
+    EXPECT_EQ(before->getStableId(), after->getStableId());
+    
+    // Keyed children keep their identity when reordered
+    EXPECT_EQ(before->getChildren()[0]->getStableId(), after->getChildren()[1]->getStableId());
+    EXPECT_EQ(before->getChildren()[1]->getStableId(), after->getChildren()[0]->getStableId());
+    EXPECT_NE(before->getChildren()[0]->getStableId(), before->getChildren()[1]->getStableId());
+    EXPECT_EQ(before->getChildren()[2]->getStableId(), after->getChildren()[2]->getStableId());
+    
+    // A different tag at the same position is a different node
+    auto other = VNode::createElement("View", Props(), VNode::createElement("Input"));
+    auto same = VNode::createElement("View", Props(), VNode::createElement("Button"));
+    EXPECT_NE(other->getChildren()[0]->getStableId(), same->getChildren()[0]->getStableId());
+}
+
+TEST(VNodeTest, StableIdWithoutAssignmentMatchesAssigned) {
+    auto leaf = VNode::createText("leaf");
+    auto root = VNode::createElement("View", Props(),
+        VNode::createElement("View"),
+        VNode::createElement("View", Props(), VNode::createElement("Button"), leaf));
+    uint64_t derived = leaf->getStableId();
+    root->assignStableIds();
+    EXPECT_EQ(leaf->getStableId(), derived);
+}
+
+namespace {
+
+// Conditional banner above a body, built with the element factories
+VNode::Ptr renderPage(bool showBanner) {
+    std::vector<VNode::Ptr> children;
+    if (showBanner) {
+        children.push_back(elements::Text("Banner"));
+    }
+    children.push_back(elements::Text("Body"));
+    auto root = elements::View({}, std::move(children));
+    root->assignStableIds();
+    return root;
+}
+
+} // namespace
+
+TEST(VNodeTest, ImplicitKeysAreOptIn) {
+    EXPECT_FALSE(ImplicitKeys::enabled());
+    EXPECT_EQ(elements::Text("x")->getImplicitKey(), 0u);
+    
+    // Without them a conditional sibling shifts the nodes after it
+    auto with = renderPage(true);
+    auto without = renderPage(false);
+    EXPECT_NE(with->getChildren()[1]->getStableId(), without->getChildren()[0]->getStableId());
+}
+
+TEST(VNodeTest, ImplicitKeysFollowCallSites) {
+    ImplicitKeys::Scope implicitKeys;
+    auto with = renderPage(true);
+    auto without = renderPage(false);
+    auto again = renderPage(true);
+    
+    EXPECT_NE(with->getChildren()[0]->getImplicitKey(), 0u);
+    EXPECT_NE(with->getChildren()[0]->getImplicitKey(), with->getChildren()[1]->getImplicitKey());
+    EXPECT_EQ(with->getChildren()[1]->getStableId(), without->getChildren()[0]->getStableId());
+    EXPECT_EQ(with->getChildren()[0]->getStableId(), again->getChildren()[0]->getStableId());
+    
+    // An explicit key wins
+    auto keyed = renderPage(false);
+    std::as_const(*keyed).getChildren()[0]->setKey("body");
+    keyed->assignStableIds();
+    EXPECT_NE(keyed->getChildren()[0]->getStableId(), without->getChildren()[0]->getStableId());
+}
+
+TEST(VNodeTest, ImplicitKeysNumberLoopItems) {
+    ImplicitKeys::Scope implicitKeys;
+    auto renderList = [](size_t count) {
+        auto list = elements::View();
+        for (size_t i = 0; i < count; ++i) {
+            list->appendChild(elements::Text("Row " + std::to_string(i)));
+            list->appendChild(elements::View());  // Separator
+        }
+        list->assignStableIds();
+        return list;
+    };
+    
+    auto three = renderList(3);
+    auto four = renderList(4);
+    const auto& rows = std::as_const(*three).getChildren();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        for (size_t j = i + 1; j < rows.size(); ++j) {
+            EXPECT_NE(rows[i]->getStableId(), rows[j]->getStableId());
+        }
+        EXPECT_EQ(rows[i]->getStableId(), std::as_const(*four).getChildren()[i]->getStableId());
+    }
+    
+    // Removing an item renumbers the ones after it, like a rebuilt list
+    auto first = rows[0];
+    uint64_t firstKey = first->getImplicitKey();
+    three->removeChild(first);
+    three->assignStableIds();
+    const auto& remaining = std::as_const(*three).getChildren();
+    EXPECT_EQ(remaining[1]->getImplicitKey(), firstKey);
+    auto two = renderList(2);
+    EXPECT_EQ(remaining[1]->getStableId(), std::as_const(*two).getChildren()[0]->getStableId());
+}
+
+TEST(VNodeTest, DuplicateKeysGetDistinctStableIds) {
+    auto renderList = [](std::initializer_list<const char*> keys) {
+        auto list = elements::View();
+        for (const char* key : keys) {
+            auto row = elements::View();
+            row->setKey(key);
+            list->appendChild(row);
+        }
+        return list;
+    };
+    
+    auto list = renderList({"a", "b", "a"});
+    const auto& rows = std::as_const(*list).getChildren();
+    
+    // Derived on demand, before any assignStableIds()
+    StableId lastDerived = rows[2]->getStableId();
+    list->assignStableIds();
+    EXPECT_NE(rows[0]->getStableId(), rows[2]->getStableId());
+    EXPECT_EQ(rows[2]->getStableId(), lastDerived);
+    
+    // The first sibling with the key keeps the id it has with unique keys
+    auto unique = renderList({"a", "b", "c"});
+    unique->assignStableIds();
+    EXPECT_EQ(rows[0]->getStableId(), std::as_const(*unique).getChildren()[0]->getStableId());
+    EXPECT_EQ(rows[1]->getStableId(), std::as_const(*unique).getChildren()[1]->getStableId());
+    
+    ChildStableIds ids(list->getStableId());
+    for (const auto& row : rows) {
+        EXPECT_EQ(ids.next(*row), row->getStableId());
+    }
+}
+
+TEST(VNodeTest, HoistedSubtreesKeepTheirStableIds) {
+    Props labelProps;
+    labelProps.set(keys::fontSize, 12);
+    auto subtitle = VNode::createText("Subtitle");
+    auto header = VNode::hoist(VNode::createElement("View", Props(),
+        VNode::createText("Title", labelProps),
+        VNode::createElement("View", Props(), subtitle)));
+    EXPECT_TRUE(header->isHoisted());
+    EXPECT_TRUE(header->isFrozen());
+    EXPECT_TRUE(header->isStatic());
+    
+    auto render = [&header](const std::string& body) {
+        return VNode::createElement("View", Props(), header, VNode::createText(body));
+    };
+    
+    auto first = render("a");
+    first->assignStableIds();
+    uint64_t subtitleId = subtitle->getStableId();
+    
+    // Reused unchanged: ids are still right after the skip
+    auto second = render("b");
+    second->assignStableIds();
+    EXPECT_EQ(subtitle->getStableId(), subtitleId);
+    
+    // Moved: the subtree is assigned again
+    auto moved = VNode::createElement("View", Props(), VNode::createText("first"), header);
+    moved->assignStableIds();
+    uint64_t movedId = subtitle->getStableId();
+    EXPECT_NE(movedId, subtitleId);
+    EXPECT_EQ(movedId, VNode::deriveStableId(
+        VNode::deriveStableId(header->getStableId(), *std::as_const(*header).getChildren()[1], 1),
+        *subtitle, 0));
+}
+
+TEST(VNodeTest, StaticDetection) {
+    EXPECT_TRUE(VNode::createElement("View", Props(), VNode::createText("x"))->isStatic());
+    
+    Props withHandler;
+    withHandler.set(keys::onClick, std::function<void()>([] {}));
+    EXPECT_FALSE(VNode::createElement("View", Props(),
+        VNode::createElement("Button", withHandler))->isStatic());
+    
+    struct Empty : Component {
+        VNode::Ptr render() override { return nullptr; }
+    };
+    EXPECT_FALSE(VNode::createElement("View", Props(), VNode::createComponent(std::make_shared<Empty>()))->isStatic());
+}
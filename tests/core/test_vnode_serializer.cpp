@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "reactpp/core/VNodeSerializer.hpp"
+#include "reactpp/renderer/RendererTypes.hpp"
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace reactpp;
+
+namespace {
+
+VNode::Ptr buildSample() {
+    Props viewProps;
+    viewProps.set(keys::width, 320);
+    viewProps.set(keys::x, -15);
+    viewProps.set(keys::backgroundColor, 0x336699FFu);
+    viewProps.set("opacity", 0.5f);
+    viewProps.set("scale", 1.25);
+    viewProps.set("visible", true);
+    viewProps.set(keys::gradientDirection, std::string("vertical"));
+    viewProps.set(keys::gradient, std::vector<renderer::GradientStop>{{0.0f, 0xFF0000FF}, {1.0f, 0x0000FFFF}});
+
+    Props buttonProps;
+    buttonProps.set(keys::width, 100);
+
+    auto button = VNode::createElement("Button", buttonProps, {VNode::createText("Click")});
+    button->setKey("submit");
+
+    return VNode::createElement("View", viewProps, {
+        VNode::createText("Title"),
+        button,
+        VNode::createFragment({VNode::createElement("View")})
+    });
+}
+
+} // namespace
+
+TEST(VNodeSerializerTest, RoundTripPreservesTree) {
+    auto original = buildSample();
+    std::string bytes = encodeTree(*original);
+    auto decoded = decodeTree(bytes);
+
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(*decoded, *original);
+    EXPECT_EQ(decoded->structuralHash(), original->structuralHash());
+
+    const auto& children = decoded->getChildren();
+    ASSERT_EQ(children.size(), 3u);
+    EXPECT_EQ(children[1]->getKey().value(), "submit");
+    EXPECT_EQ(children[1]->getParent().lock(), decoded);
+    EXPECT_FLOAT_EQ(decoded->getProps().get<float>("opacity"), 0.5f);
+    EXPECT_EQ(decoded->getProps().get<int>(keys::x), -15);
+}
+
+TEST(VNodeSerializerTest, SkipsUnserializableProps) {
+    Props props;
+    props.set(keys::width, 10);
+    props.set(keys::onClick, std::function<void()>([] {}));
+    auto node = VNode::createElement("Button", props);
+
+    auto decoded = decodeTree(encodeTree(*node));
+    EXPECT_EQ(decoded->getProps().size(), 1u);
+    EXPECT_FALSE(decoded->getProps().has(keys::onClick));
+}
+
+TEST(VNodeSerializerTest, StreamsSeveralTrees) {
+    std::ostringstream out;
+    {
+        VNodeWriter writer(out);
+        writer.write(*buildSample());
+        writer.write(*VNode::createText("second"));
+    }
+
+    std::string bytes = out.str();
+    VNodeReader reader(bytes);
+    auto first = reader.read();
+    auto second = reader.read();
+    EXPECT_TRUE(reader.atEnd());
+    EXPECT_EQ(*first, *buildSample());
+    EXPECT_EQ(second->getText(), "second");
+}
+
+TEST(VNodeSerializerTest, NamesAreWrittenOnce) {
+    auto root = VNode::createElement("View");
+    for (int i = 0; i < 100; ++i) {
+        Props props;
+        props.set(keys::width, i);
+        root->appendChild(VNode::createElement("SomeLongCustomElementName", props));
+    }
+    std::string bytes = encodeTree(*root);
+    EXPECT_EQ(bytes.find("SomeLongCustomElementName"), bytes.rfind("SomeLongCustomElementName"));
+    EXPECT_LT(bytes.size(), 100u * 8);
+}
+
+TEST(VNodeSerializerTest, DeepTreesDoNotRecurse) {
+    auto root = VNode::createElement("View");
+    auto current = root;
+    for (int i = 0; i < 100000; ++i) {
+        auto child = VNode::createElement("View");
+        current->appendChild(child);
+        current = child;
+    }
+
+    auto decoded = decodeTree(encodeTree(*root));
+    size_t depth = 0;
+    decoded->visitPreOrder([&depth](const VNode&) { ++depth; });
+    EXPECT_EQ(depth, 100001u);
+
+    // Unlink iteratively so destruction doesn't recurse either
+    for (auto tree : {root, decoded}) {
+        while (!tree->getChildren().empty()) {
+            auto child = tree->getChildren()[0];
+            tree->removeChild(child);
+            tree = child;
+        }
+    }
+}
+
+TEST(VNodeSerializerTest, RejectsMalformedInput) {
+    EXPECT_THROW(decodeTree("nope"), std::runtime_error);
+
+    std::string bytes = encodeTree(*buildSample());
+    EXPECT_THROW(decodeTree(std::string_view(bytes).substr(0, bytes.size() / 2)), std::runtime_error);
+
+    bytes[4] = 99;  // Version byte
+    EXPECT_THROW(decodeTree(bytes), std::runtime_error);
+}
+
+TEST(VNodeSerializerTest, RejectsOversizedGradient) {
+    Props props;
+    props.set(keys::gradient, std::vector<renderer::GradientStop>{{0.0f, 0xFF0000FF}});
+    std::string bytes = encodeTree(*VNode::createText("t", props));
+
+    // The stream ends with the stop count (1) and one 8-byte stop. Replace
+    // them with a count of 2^61, for which count * 8 wraps to 0.
+    ASSERT_GT(bytes.size(), 9u);
+    ASSERT_EQ(bytes[bytes.size() - 9], 1);
+    bytes.resize(bytes.size() - 9);
+    bytes.append(8, '\x80');
+    bytes.push_back('\x20');
+    EXPECT_THROW(decodeTree(bytes), std::runtime_error);
+}
@@ -8,3 +8,27 @@ TEST(EventManagerTest, Placeholder) {
     EXPECT_TRUE(true);
 }
 
+
+TEST(EventManagerTest, HandlersFollowStableIds) {
+    using namespace reactpp;
+    
+    auto render = [](bool withButton) {
+        auto root = VNode::createElement("View");
+        if (withButton) {
+            root->appendChild(VNode::createElement("Button"));
+        }
+        return root;
+    };
+    
+    EventManager manager;
+    auto first = render(true);
+    uint64_t buttonId = first->getChildren()[0]->getStableId();
+    manager.registerHandler(buttonId, "click", [](SyntheticEvent&) {});
+    
+    auto second = render(true);
+    manager.retainTree(second);
+    EXPECT_EQ(manager.getHandlers(second->getChildren()[0]->getStableId(), "click").size(), 1u);
+    
+    manager.retainTree(render(false));
+    EXPECT_TRUE(manager.getHandlers(buttonId, "click").empty());
+}
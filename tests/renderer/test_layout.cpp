@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "reactpp/renderer/LayoutEngine.hpp"
+#include "reactpp/elements/Elements.hpp"
 
 using namespace reactpp::renderer;
 
@@ -8,3 +9,39 @@ TEST(LayoutEngineTest, Placeholder) {
     EXPECT_TRUE(true);
 }
 
+
+TEST(LayoutEngineTest, StacksViewChildren) {
+    using namespace reactpp;
+    
+    Props buttonProps;
+    buttonProps.set(keys::width, 80);
+    auto label = VNode::createText("Go");
+    auto button = elements::Button(buttonProps, label);
+    auto text = VNode::createText("hi");
+    auto root = elements::View(Props(), button, text);
+    
+    LayoutEngine engine;
+    engine.calculateLayout(root, 800, 600);
+    
+    Rect rootRect = engine.getLayout(root->getStableId());
+    EXPECT_EQ(rootRect.width, 800);
+    EXPECT_EQ(rootRect.height, 600);
+    
+    Rect buttonRect = engine.getLayout(button->getStableId());
+    EXPECT_EQ(buttonRect.x, 10);
+    EXPECT_EQ(buttonRect.y, 0);
+    EXPECT_EQ(buttonRect.width, 80);
+    EXPECT_EQ(buttonRect.height, 40);
+    
+    // Button text is centered, as the renderers draw it: 14px "Go" is
+    // estimated at 16x17
+    Rect labelRect = engine.getLayout(label->getStableId());
+    EXPECT_EQ(labelRect.x, 10 + 40 - 8);
+    EXPECT_EQ(labelRect.y, 20 - 8);
+    
+    // Next child goes below the button; text is drawn 20px below the cursor
+    Rect textRect = engine.getLayout(text->getStableId());
+    EXPECT_EQ(textRect.x, 10);
+    EXPECT_EQ(textRect.y, 50 + 20);
+    EXPECT_EQ(engine.getNodeTable().size(), 4u);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "reactpp/renderer/NodeTable.hpp"
+#include "reactpp/elements/Elements.hpp"
+
+using namespace reactpp;
+using namespace reactpp::renderer;
+
+TEST(NodeTableTest, StoresTreeInPreOrder) {
+    auto label = VNode::createText("label");
+    auto button = elements::Button(Props(), label);
+    auto root = elements::View(Props(), VNode::createText("title"), button);
+    
+    NodeTable table(*root);
+    ASSERT_EQ(table.size(), 4u);
+    EXPECT_EQ(table.vnodeIds()[0], root->getId());
+    EXPECT_EQ(table.vnodeIds()[2], button->getId());
+    EXPECT_EQ(table.vnodeIds()[3], label->getId());
+    
+    // Subtrees are contiguous ranges
+    EXPECT_EQ(table.subtreeEnd(0), 4u);
+    EXPECT_EQ(table.subtreeEnd(1), 2u);
+    EXPECT_EQ(table.subtreeEnd(2), 4u);
+}
+
+TEST(NodeTableTest, HandlesFollowLinks) {
+    auto root = elements::View(Props(),
+        elements::Button(Props()),
+        elements::Text("hello"),
+        elements::View());
+    NodeTable table(*root);
+    
+    NodeHandle top = table.root();
+    ASSERT_TRUE(top);
+    EXPECT_EQ(top.tag(), tags::View);
+    EXPECT_FALSE(top.parent());
+    
+    std::vector<VNodeType> childTypes;
+    for (NodeHandle child = top.firstChild(); child; child = child.nextSibling()) {
+        EXPECT_EQ(child.parent(), top);
+        childTypes.push_back(child.type());
+    }
+    EXPECT_EQ(childTypes.size(), 3u);
+    EXPECT_EQ(top.firstChild().tag(), tags::Button);
+    EXPECT_EQ(top.firstChild().nextSibling().text(), "hello");
+    EXPECT_EQ(table.find(root->getId()), top);
+    EXPECT_FALSE(table.find(0));
+}
+
+TEST(NodeTableTest, ResolvesSpecAndStyle) {
+    Props props;
+    props.set(keys::width, 200);
+    props.set(keys::color, std::string("#112233"));
+    props.set(keys::fontSize, 20);
+    auto root = VNode::createElement(tags::Button, props, {VNode::createText("ok")});
+    
+    NodeTable table(*root);
+    NodeHandle button = table.root();
+    EXPECT_EQ(button.spec().width, 200);
+    EXPECT_EQ(button.spec().height, LayoutSpec::Auto);
+    EXPECT_EQ(button.style().backgroundColor, 0x4A90E2FFu);  // Button default
+    EXPECT_EQ(button.style().color, 0x112233FFu);
+    
+    // Text inherits its parent's style
+    EXPECT_EQ(button.firstChild().style().fontSize, 20);
+}
+
+TEST(NodeTableTest, TextNodesCarryOwnStyle) {
+    Props textProps;
+    textProps.set(keys::fontSize, 32);
+    auto label = elements::Text("Count: 0", textProps);
+    EXPECT_EQ(label->getType(), VNodeType::Text);  // No wrapper element
+    
+    Props viewProps;
+    viewProps.set(keys::color, 0x336699FFu);
+    auto root = elements::View(viewProps, label, elements::Text("plain"));
+    
+    NodeTable table(*root);
+    ASSERT_EQ(table.size(), 3u);
+    EXPECT_EQ(table.styles()[1].fontSize, 32);            // Own
+    EXPECT_EQ(table.styles()[1].color, 0x336699FFu);      // Inherited
+    EXPECT_EQ(table.styles()[2].fontSize, 16);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "reactpp/renderer/RenderTree.hpp"
+#include <utility>
 
 using namespace reactpp::renderer;
 
@@ -8,3 +9,65 @@ TEST(RenderTreeTest, Placeholder) {
     EXPECT_TRUE(true);
 }
 
+TEST(RenderTreeTest, ReusesNodesAcrossUpdates) {
+    using namespace reactpp;
+    
+    auto render = [](const std::string& label) {
+        return VNode::createElement("View", Props(),
+            VNode::createElement("Button", Props(), VNode::createText("ok")),
+            VNode::createText(label));
+    };
+    
+    RenderTree tree;
+    auto first = render("one");
+    tree.update(first);
+    EXPECT_EQ(tree.size(), 4u);
+    
+    uint64_t buttonId = first->getChildren()[0]->getStableId();
+    uint64_t labelId = first->getChildren()[1]->getStableId();
+    auto button = tree.getNode(buttonId);
+    ASSERT_NE(button, nullptr);
+    EXPECT_TRUE(button->needsRepaint);
+    button->needsRepaint = false;
+    tree.getNode(labelId)->needsRepaint = false;
+    
+    auto second = render("two");
+    tree.update(second);
+    EXPECT_EQ(tree.getNode(buttonId), button);
+    EXPECT_EQ(button->vnode, second->getChildren()[0]);
+    EXPECT_FALSE(button->needsRepaint);
+    EXPECT_TRUE(tree.getNode(labelId)->needsRepaint);
+    
+    tree.update(VNode::createElement("View"));
+    EXPECT_EQ(tree.size(), 1u);
+    EXPECT_EQ(tree.getNode(buttonId), nullptr);
+}
+
+TEST(RenderTreeTest, SkipsHoistedSubtrees) {
+    using namespace reactpp;
+    
+    auto header = VNode::hoist(VNode::createElement("View", Props(),
+        VNode::createText("Title"),
+        VNode::createElement("Button", Props(), VNode::createText("Help"))));
+    auto render = [&header](const std::string& label) {
+        return VNode::createElement("View", Props(), header, VNode::createText(label));
+    };
+    
+    RenderTree tree;
+    tree.update(render("one"));
+    EXPECT_EQ(tree.size(), 6u);
+    uint64_t helpId = std::as_const(*header).getChildren()[1]->getStableId();
+    auto help = tree.getNode(helpId);
+    ASSERT_NE(help, nullptr);
+    help->needsRepaint = false;
+    
+    tree.update(render("two"));
+    EXPECT_EQ(tree.size(), 6u);
+    EXPECT_EQ(tree.getNode(helpId), help);
+    EXPECT_FALSE(help->needsRepaint);
+    
+    // Moved below another node: laid out again and repainted
+    tree.update(VNode::createElement("View", Props(), VNode::createText("first"), header));
+    EXPECT_NE(tree.getNode(std::as_const(*header).getChildren()[1]->getStableId()), nullptr);
+    EXPECT_EQ(tree.getNode(helpId), nullptr);
+}
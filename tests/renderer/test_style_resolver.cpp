@@ -8,3 +8,90 @@ TEST(StyleResolverTest, Placeholder) {
     EXPECT_TRUE(true);
 }
 
+TEST(StyleResolverTest, InheritsAndReusesAcrossRenders) {
+    using namespace reactpp;
+    
+    auto render = [](int fontSize) {
+        Props rootProps;
+        rootProps.set(keys::fontSize, fontSize);
+        rootProps.set(keys::backgroundColor, 0x112233FFu);
+        Props buttonProps;
+        buttonProps.set(keys::color, 0xFF0000FFu);
+        return VNode::createElement("View", rootProps, {
+            VNode::createElement("Button", buttonProps),
+            VNode::createText("hi")
+        });
+    };
+    
+    StyleResolver resolver;
+    auto first = render(20);
+    resolver.computeStyles(first);
+    EXPECT_EQ(resolver.cacheSize(), 3u);
+    EXPECT_EQ(resolver.reusedCount(), 0u);
+    
+    const Props* button = resolver.getComputedStyles(first->getChildren()[0]->getStableId());
+    ASSERT_NE(button, nullptr);
+    EXPECT_EQ(button->get<int>(keys::fontSize), 20);             // Inherited
+    EXPECT_EQ(button->get<uint32_t>(keys::color), 0xFF0000FFu);  // Own
+    EXPECT_FALSE(button->has(keys::backgroundColor));           // Not inherited
+    
+    // Same tree, new nodes: every entry is reused
+    resolver.computeStyles(render(20));
+    EXPECT_EQ(resolver.reusedCount(), 3u);
+    
+    // A changed inherited value reaches the children
+    auto third = render(24);
+    resolver.computeStyles(third);
+    EXPECT_EQ(resolver.reusedCount(), 0u);
+    EXPECT_EQ(resolver.resolveStyles(third->getChildren()[1]).get<int>(keys::fontSize), 24);
+    
+    // Removed nodes are dropped
+    resolver.computeStyles(VNode::createElement("View"));
+    EXPECT_EQ(resolver.cacheSize(), 1u);
+}
+
+TEST(StyleResolverTest, SkipsHoistedSubtrees) {
+    using namespace reactpp;
+    
+    Props titleProps;
+    titleProps.set(keys::color, 0x00FF00FFu);
+    auto subtitle = VNode::createText("Subtitle");
+    auto header = VNode::hoist(VNode::createElement("View", Props(),
+        VNode::createText("Title", titleProps),
+        VNode::createElement("View", Props(), subtitle)));
+    
+    auto render = [&header](int fontSize) {
+        Props rootProps;
+        rootProps.set(keys::fontSize, fontSize);
+        return VNode::createElement("View", rootProps, header, VNode::createText("body"));
+    };
+    
+    StyleResolver resolver;
+    auto first = render(20);
+    first->assignStableIds();
+    resolver.computeStyles(first);
+    EXPECT_EQ(resolver.cacheSize(), 6u);
+    EXPECT_EQ(resolver.skippedCount(), 0u);
+    uint64_t subtitleId = subtitle->getStableId();
+    
+    // Same place, same inherited styles: the subtree is skipped but its
+    // entries stay available
+    resolver.computeStyles(render(20));
+    EXPECT_EQ(resolver.skippedCount(), 1u);
+    EXPECT_EQ(resolver.reusedCount(), 3u);  // Root, header, body
+    EXPECT_EQ(resolver.cacheSize(), 6u);
+    ASSERT_NE(resolver.getComputedStyles(subtitleId), nullptr);
+    EXPECT_EQ(resolver.getComputedStyles(subtitleId)->get<int>(keys::fontSize), 20);
+    
+    // Changed inherited styles reach into the hoisted subtree
+    resolver.computeStyles(render(24));
+    EXPECT_EQ(resolver.skippedCount(), 0u);
+    EXPECT_EQ(resolver.getComputedStyles(subtitleId)->get<int>(keys::fontSize), 24);
+    
+    // Without the hoisted subtree its entries are dropped
+    Props rootProps;
+    rootProps.set(keys::fontSize, 24);
+    resolver.computeStyles(VNode::createElement("View", rootProps, VNode::createText("body")));
+    EXPECT_EQ(resolver.cacheSize(), 2u);
+    EXPECT_EQ(resolver.getComputedStyles(subtitleId), nullptr);
+}
@@ -1,10 +1,156 @@
 #include <gtest/gtest.h>
 #include "reactpp/scheduler/UpdateScheduler.hpp"
+#include "reactpp/scheduler/WorkLoop.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
 
 using namespace reactpp;
 
+namespace {
+
+VNode::Ptr list(size_t rows, bool rotated = false) {
+    std::vector<VNode::Ptr> children;
+    for (size_t i = 0; i < rows; ++i) {
+        auto row = VNode::createElement("View", Props(), VNode::createText("row"));
+        row->setKey("row" + std::to_string(i));
+        children.push_back(row);
+    }
+    if (rotated) {
+        std::rotate(children.begin(), children.end() - 1, children.end());
+    }
+    return VNode::createElement("View", Props(), std::move(children));
+}
+
+// Clock that advances one millisecond per reading, so a tick's budget
+// bounds the number of units it performs
+struct FakeClock {
+    uint64_t now = 0;
+    WorkLoop::Clock clock() {
+        return [this]() { return now++; };
+    }
+};
+
+} // namespace
+
 TEST(UpdateSchedulerTest, Placeholder) {
     auto scheduler = std::make_shared<UpdateScheduler>();
     EXPECT_NE(scheduler, nullptr);
 }
 
+TEST(UpdateSchedulerTest, TakesUpdatesByPriorityThenAge) {
+    UpdateScheduler scheduler;
+    auto low = FiberNode::create(VNode::createText("low"));
+    auto first = FiberNode::create(VNode::createText("first"));
+    auto second = FiberNode::create(VNode::createText("second"));
+    auto urgent = FiberNode::create(VNode::createText("urgent"));
+    scheduler.scheduleUpdate(low, Priority::Low);
+    scheduler.scheduleUpdate(first, Priority::Normal);
+    scheduler.scheduleUpdate(second, Priority::Normal);
+    scheduler.scheduleUpdate(urgent, Priority::Immediate);
+
+    EXPECT_EQ(scheduler.takeUpdate(), urgent);
+    EXPECT_EQ(scheduler.takeUpdate(), first);
+    EXPECT_EQ(scheduler.takeUpdate(), second);
+    EXPECT_EQ(scheduler.takeUpdate(), low);
+    EXPECT_FALSE(scheduler.hasPendingUpdates());
+    EXPECT_EQ(scheduler.takeUpdate(), nullptr);
+}
+
+TEST(WorkLoopTest, SlicesWorkAcrossTicksAndCommitsOnce) {
+    FakeClock time;
+    WorkLoop loop(std::make_shared<UpdateScheduler>(), time.clock());
+    loop.setFrameBudget(100);
+    std::vector<FiberNode::Ptr> commits;
+    loop.onCommit([&commits](const FiberNode::Ptr& root) { commits.push_back(root); });
+
+    auto tree = list(1000);
+    loop.schedule(tree);
+    int ticks = 0;
+    while (loop.run()) {
+        ++ticks;
+        // Nothing is visible until the whole tree is done
+        EXPECT_TRUE(commits.empty());
+        EXPECT_EQ(loop.committed(), nullptr);
+        ASSERT_LT(ticks, 1000);
+    }
+    EXPECT_GT(ticks, 10);  // 2001 fibers at under 100 per tick
+    ASSERT_EQ(commits.size(), 1u);
+    EXPECT_EQ(loop.committed(), commits[0]);
+    EXPECT_EQ(commits[0]->vnode, tree);
+    EXPECT_EQ(commits[0]->effectTag, EffectTag::Placement);
+    EXPECT_FALSE(loop.isRendering());
+    EXPECT_FALSE(loop.run());
+}
+
+TEST(WorkLoopTest, NextRenderDiffsAgainstCommittedTree) {
+    FakeClock time;
+    WorkLoop loop(std::make_shared<UpdateScheduler>(), time.clock());
+    loop.setFrameBudget(50);
+    std::vector<FiberNode::Ptr> commits;
+    loop.onCommit([&commits](const FiberNode::Ptr& root) { commits.push_back(root); });
+
+    loop.schedule(list(500));
+    while (loop.run()) {
+    }
+    loop.schedule(list(500, true));
+    while (loop.run()) {
+    }
+    ASSERT_EQ(commits.size(), 2u);
+    EXPECT_EQ(commits[1]->effectTag, EffectTag::None);
+    ASSERT_EQ(commits[1]->effectList.size(), 1u);
+    EXPECT_EQ(*commits[1]->effectList[0]->vnode->getKey(), "row499");
+
+    // Scheduling no tree removes the committed one
+    loop.schedule(nullptr);
+    EXPECT_FALSE(loop.run());
+    ASSERT_EQ(commits.size(), 3u);
+    EXPECT_EQ(commits[2]->effectTag, EffectTag::Deletion);
+    EXPECT_EQ(loop.committed(), nullptr);
+}
+
+TEST(WorkLoopTest, UpdatesScheduledMidRenderWaitForTheCommit) {
+    FakeClock time;
+    WorkLoop loop(std::make_shared<UpdateScheduler>(), time.clock());
+    loop.setFrameBudget(20);
+    std::vector<VNode::Ptr> committed;
+    loop.onCommit([&committed](const FiberNode::Ptr& root) { committed.push_back(root->vnode); });
+
+    auto first = list(100);
+    auto second = list(100, true);
+    loop.schedule(first);
+    EXPECT_TRUE(loop.run());
+    EXPECT_TRUE(loop.isRendering());
+    loop.schedule(second, Priority::Immediate);
+    while (loop.run()) {
+    }
+    ASSERT_EQ(committed.size(), 2u);
+    EXPECT_EQ(committed[0], first);
+    EXPECT_EQ(committed[1], second);
+}
+
+TEST(WorkLoopTest, StopDropsTheRenderInProgress) {
+    FakeClock time;
+    WorkLoop loop(std::make_shared<UpdateScheduler>(), time.clock());
+    loop.setFrameBudget(10);
+    int commits = 0;
+    loop.onCommit([&commits](const FiberNode::Ptr&) { ++commits; });
+
+    loop.schedule(list(100));
+    EXPECT_TRUE(loop.run());
+    loop.stop();
+    EXPECT_FALSE(loop.isRendering());
+    EXPECT_FALSE(loop.work());
+    EXPECT_FALSE(loop.run());
+    EXPECT_EQ(commits, 0);
+}
+
+TEST(WorkLoopTest, SmallTreeFinishesInOneTick) {
+    WorkLoop loop(std::make_shared<UpdateScheduler>());
+    int commits = 0;
+    loop.onCommit([&commits](const FiberNode::Ptr&) { ++commits; });
+    loop.schedule(list(3));
+    EXPECT_FALSE(loop.run());
+    EXPECT_EQ(commits, 1);
+    EXPECT_NE(loop.committed(), nullptr);
+}